@@ -0,0 +1,45 @@
+/**
+ * @file BCM2835Transport.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef BCM2835_TRANSPORT_H_
+#define BCM2835_TRANSPORT_H_
+
+#include <cstdint>
+
+#include "SPITransport.h"
+
+/**
+ * @brief SPI transport that drives the Raspberry Pi SPI0 peripheral through
+ *        the bcm2835 library.
+ *
+ * Requires root privileges (or access to `/dev/mem`) at runtime.
+ */
+class BCM2835Transport : public SPITransport {
+
+public:
+
+  /**
+   * @brief Initializes the bcm2835 library and configures SPI0 for the
+   *        MAX7219 (MSB first, mode 0, 6.25MHz, CS0 active low).
+   * 
+   * @return `1` if initialization succeeded or `0` otherwise
+   */
+  int init() override;
+
+  /**
+   * @brief Ends SPI operation and closes the bcm2835 library.
+   * 
+   * @return `1` if the library was closed successfully or `0` otherwise
+   */
+  int close() override;
+
+protected:
+
+  void do_transfer(char* buffer, std::uint32_t buffer_length) override;
+
+};  // class BCM2835Transport
+
+#endif  // BCM2835_TRANSPORT_H_
@@ -0,0 +1,344 @@
+/**
+ * @file ChainImageView.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_CHAIN_IMAGE_VIEW_H_
+#define SCROLLER_CHAIN_IMAGE_VIEW_H_
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#include "MatrixImage.h"
+#include "MatrixChainImage.h"
+
+/**
+ * @brief A non-owning, read-only window onto a `MatrixChainImage` that
+ *        starts at any column and has any width.
+ *
+ * A view only refers to the pixels of the image it was made from, so
+ * cropping an image or moving a window across it does not copy any pixels or
+ * allocate memory. Columns of the view that lie beyond the right edge of the
+ * image are blank, or, for a wrapping view, are taken from the start of the
+ * image again so that a message scrolls endlessly. The image must outlive
+ * the view.
+ *
+ * ```
+ * for (std::size_t column = 0; ; column++) {
+ *   device.display(ChainImageView{canvas, column, device_width, true});
+ * }
+ * ```
+ */
+class ChainImageView {
+
+private:
+
+  /**
+   * Image that the view refers to.
+   */
+  const MatrixChainImage* image;
+
+  /**
+   * Column of the image at which the view starts.
+   */
+  std::size_t column_offset;
+
+  /**
+   * Width of the view in pixels.
+   */
+  std::size_t width;
+
+  /**
+   * Whether the view wraps around to the start of the image past its right
+   * edge.
+   */
+  bool wrap;
+
+public:
+
+  /**
+   * @brief Constructs a view of an entire image.
+   *
+   * @param image image to view
+   */
+  ChainImageView(const MatrixChainImage& image);
+
+  /**
+   * @brief Constructs a view of part of an image.
+   *
+   * @param image image to view
+   * @param column_offset column of the image at which the view starts; any
+   *                      column for a wrapping view
+   * @param width width of the view in pixels
+   * @param wrap whether the view wraps around to the start of the image past
+   *             its right edge
+   */
+  ChainImageView(const MatrixChainImage& image, std::size_t column_offset,
+                 std::size_t width, bool wrap = false);
+
+  /**
+   * @brief Returns the image that this view refers to.
+   *
+   * @return viewed image
+   */
+  const MatrixChainImage& get_image() const;
+
+  /**
+   * @brief Returns the column of the image at which this view starts.
+   *
+   * @return column offset of the view
+   */
+  std::size_t get_column_offset() const;
+
+  /**
+   * @brief Returns the width of the view in pixels.
+   *
+   * @return width of the view in pixels
+   */
+  std::size_t get_pixel_width() const;
+
+  /**
+   * @brief Returns whether the view wraps around to the start of the image
+   *        past its right edge.
+   *
+   * @return `true` if the view wraps
+   */
+  bool is_wrapping() const;
+
+  /**
+   * @brief Returns a view of part of this view.
+   *
+   * @param column_offset column of this view at which the new view starts
+   * @param width width of the new view in pixels; it is limited to the part
+   *              of this view that remains to the right of `column_offset`
+   * @return view of the same image that wraps if this view does
+   */
+  ChainImageView get_subview(std::size_t column_offset,
+                             std::size_t width) const;
+
+  /**
+   * @brief Returns the value of the pixel at the specified position in the
+   *        context of this view.
+   *
+   * @param row row of the pixel to be retrieved
+   * @param col column of the pixel to be retrieved
+   * @return `1` if the specified pixel is set on or `0` if the pixel is set
+   *         off
+   */
+  std::uint_fast8_t get_pixel(std::size_t row, std::size_t col) const;
+
+  /**
+   * @brief Returns the data for an entire row of a specified matrix within
+   *        this view, where matrices start at the first column of the view.
+   *
+   * @param matrix index of the matrix within this view to retrieve data from
+   * @param row row for which to return image data
+   * @return image data for a row where each digit in the binary
+   *         representation of the value represents a column within the row
+   */
+  std::uint_fast8_t get_row_of_matrix(std::size_t matrix,
+                                      std::size_t row) const;
+
+  /**
+   * @brief Gathers eight consecutive 8x8 sections of this view, starting at
+   *        any column, into one word per section.
+   *
+   * Each word is laid out as described for `MatrixImage::get_word()`.
+   * Columns beyond the right edge of this view are blank.
+   *
+   * @param column column of this view at which the first section starts
+   * @param words array of eight words into which to gather the sections
+   */
+  void get_matrix_words(std::size_t column, std::uint64_t* words) const;
+
+  /**
+   * @brief Copies this view into an existing image, a whole row word at a
+   *        time and without allocating memory.
+   *
+   * The view is copied from its first column into the first column of the
+   * image. Columns of the image beyond the width of this view are blank.
+   *
+   * @param image image into which to copy the view
+   */
+  void copy_to(MatrixChainImage& image) const;
+
+private:
+
+  /**
+   * @brief Returns 64 consecutive columns of a row of this view.
+   *
+   * @param row row of the view to read from
+   * @param column column of the view of the first bit to return
+   * @return the specified columns with the first column in the most-
+   *         significant bit; columns beyond the view are `0`
+   */
+  std::uint64_t read_row_bits(std::size_t row, std::size_t column) const;
+
+};  // class ChainImageView
+
+inline ChainImageView::ChainImageView(const MatrixChainImage& image)
+  : image{&image}
+  , column_offset{0}
+  , width{image.get_pixel_width()}
+  , wrap{false} { /* no body */ }
+
+inline ChainImageView::ChainImageView(const MatrixChainImage& image,
+                                      std::size_t column_offset,
+                                      std::size_t width, bool wrap)
+  : image{&image}
+  , column_offset{column_offset}
+  , width{width}
+  , wrap{wrap} { /* no body */ }
+
+inline const MatrixChainImage& ChainImageView::get_image() const {
+  return *image;
+}
+
+inline std::size_t ChainImageView::get_column_offset() const {
+  return column_offset;
+}
+
+inline std::size_t ChainImageView::get_pixel_width() const {
+  return width;
+}
+
+inline bool ChainImageView::is_wrapping() const {
+  return wrap;
+}
+
+inline ChainImageView ChainImageView::get_subview(std::size_t column_offset,
+                                                  std::size_t width) const {
+
+  std::size_t remaining{
+    column_offset < this->width ? this->width - column_offset : 0};
+
+  return ChainImageView{
+    *image,
+    this->column_offset + column_offset,
+    width < remaining ? width : remaining,
+    wrap
+  };
+}
+
+inline std::uint_fast8_t ChainImageView::get_pixel(std::size_t row,
+                                                   std::size_t col) const {
+
+  // throw an exception if the column index provided is invalid
+  if (col >= width) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "col index must be less than view width of "
+      + std::to_string(width) + "; provided value was "
+      + std::to_string(col)
+    };
+  }
+
+  // throw an exception if the row index provided is invalid
+  if (row >= MatrixImage::HEIGHT) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "row index must be less than matrix height of "
+      + std::to_string(MatrixImage::HEIGHT) + "; provided value was "
+      + std::to_string(row)
+    };
+  }
+
+  return read_row_bits(row, col) >> 63;
+}
+
+inline std::uint_fast8_t ChainImageView::get_row_of_matrix(
+    std::size_t matrix, std::size_t row) const {
+
+  // a view does not have to be a whole number of matrices wide, so a matrix
+  // is valid as long as some of its columns are within the view
+  if (matrix * MatrixImage::WIDTH >= width) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "matrix index must start within view width of "
+      + std::to_string(width) + "; provided value was "
+      + std::to_string(matrix)
+    };
+  }
+
+  // throw an exception if the row index provided is invalid
+  if (row >= MatrixImage::HEIGHT) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "row index must be less than matrix height of "
+      + std::to_string(MatrixImage::HEIGHT) + "; provided value was "
+      + std::to_string(row)
+    };
+  }
+
+  return read_row_bits(row, matrix * MatrixImage::WIDTH) >> 56;
+}
+
+inline void ChainImageView::get_matrix_words(std::size_t column,
+                                             std::uint64_t* words) const {
+
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    words[row] = read_row_bits(row, column);
+  }
+
+  MatrixChainImage::transpose_bytes(words);
+}
+
+inline void ChainImageView::copy_to(MatrixChainImage& image) const {
+
+  // an empty image has no words to copy into
+  if (image.words_per_row == 0) {
+    return;
+  }
+
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+
+    std::uint64_t* destination =
+      image.image_data.data() + row * image.words_per_row;
+
+    for (std::size_t word = 0; word < image.words_per_row; word++) {
+      destination[word] = read_row_bits(row, 64 * word);
+    }
+
+    // bits beyond the width of the image must stay 0
+    destination[image.words_per_row - 1] &= image.last_word_mask();
+  }
+}
+
+inline std::uint64_t ChainImageView::read_row_bits(std::size_t row,
+                                                   std::size_t column) const {
+
+  if (column >= width) {
+    return 0;
+  }
+
+  // clear the columns that are beyond the right edge of the view
+  std::size_t remaining{width - column};
+  std::uint64_t mask{remaining >= 64 ? ~std::uint64_t{0}
+                                     : ~(~std::uint64_t{0} >> remaining)};
+
+  if (!wrap) {
+    return image->read_row_bits(row, column_offset + column) & mask;
+  }
+
+  // an empty image has nothing to repeat
+  std::size_t image_width{image->get_pixel_width()};
+  if (image_width == 0) {
+    return 0;
+  }
+
+  // columns past the right edge of the image read as 0, so the start of the
+  // image can be OR-ed in after them as many times as is needed to fill the
+  // word (more than once if the image is narrower than a word)
+  std::size_t image_column{(column_offset + column) % image_width};
+  std::uint64_t bits{image->read_row_bits(row, image_column)};
+  for (std::size_t filled = image_width - image_column; filled < 64;
+       filled += image_width) {
+    bits |= image->read_row_bits(row, 0) >> filled;
+  }
+
+  return bits & mask;
+}
+
+#endif  // SCROLLER_CHAIN_IMAGE_VIEW_H_
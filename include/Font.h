@@ -15,6 +15,7 @@
 #include <cstdint>
 
 #include "Glyph.h"
+#include "FontFile.h"
 
 /**
  * @brief A font that holds data on how to draw UTF-8 characters and can be
@@ -29,13 +30,103 @@ public:
    */
   static const std::size_t FONT_CHAR_COUNT{256};
 
+  /**
+   * Size in bytes of the glyph data of a font: one byte for each row of each
+   * glyph, ordered by code point.
+   */
+  static const std::size_t FONT_DATA_SIZE{FONT_CHAR_COUNT * Glyph::HEIGHT};
+
+  /**
+   * Rows of a glyph shifted to the right by a number of bits so that they can
+   * be drawn at any column of an image; the rows are split into the bytes
+   * that fall on the matrix where the glyph starts and on the next matrix.
+   */
+  struct ShiftedGlyph {
+
+    /**
+     * Part of each row of the glyph that falls on the first matrix.
+     */
+    std::array<std::uint8_t, Glyph::HEIGHT> first_rows;
+
+    /**
+     * Part of each row of the glyph that falls on the second matrix.
+     */
+    std::array<std::uint8_t, Glyph::HEIGHT> second_rows;
+
+    /**
+     * Columns of the first matrix covered by the width of the glyph.
+     */
+    std::uint8_t first_mask;
+
+    /**
+     * Columns of the second matrix covered by the width of the glyph; `0` if
+     * the glyph fits on the first matrix.
+     */
+    std::uint8_t second_mask;
+
+  };
+
+  /**
+   * Number of bit offsets, within a matrix row, at which a glyph can start.
+   */
+  static const std::size_t BIT_OFFSET_COUNT{8};
+
+  /**
+   * Metrics given to a glyph of a raw font that has no pixels set to on,
+   * since a raw font holds no metrics of its own.
+   */
+  struct BlankGlyphMetrics {
+
+    /**
+     * Code point of the blank glyph.
+     */
+    std::uint8_t code_point;
+
+    /**
+     * Width of the glyph before spacing is added.
+     */
+    std::uint8_t advance;
+
+    /**
+     * Flags of the glyph, such as `Glyph::FIXED_ADVANCE`.
+     */
+    std::uint8_t flags;
+
+  };
+
+  /**
+   * Blank glyphs of raw fonts that are not zero width: a space (0x20) is `4`
+   * columns wide plus spacing, and 0xFF is a single column regardless of
+   * spacing. Font containers store these metrics for every glyph instead.
+   */
+  static const std::array<BlankGlyphMetrics, 2> RAW_BLANK_GLYPH_METRICS;
+
 private:
 
   /**
    * Array of `Glyph`s for this font where the indices of the glyphs are the
-   * UTF-8 code points of the respective characters.
+   * UTF-8 code points of the respective characters; glyphs are stored by
+   * value so that the whole table is one contiguous block.
    */
-  std::array<Glyph*, FONT_CHAR_COUNT> font_glyphs;
+  std::array<Glyph, FONT_CHAR_COUNT> font_glyphs;
+
+  /**
+   * Every glyph pre-shifted for every bit offset, indexed by code point and
+   * then by bit offset, so that drawing a glyph takes two masked byte writes
+   * per row.
+   */
+  std::array<std::array<ShiftedGlyph, BIT_OFFSET_COUNT>, FONT_CHAR_COUNT>
+    shifted_glyphs;
+
+  /**
+   * Whether glyphs are drawn with excess whitespace removed from both sides.
+   */
+  bool proportional;
+
+  /**
+   * Number of blank columns of spacing drawn at the end of each glyph.
+   */
+  std::size_t spacing;
 
 public:
 
@@ -49,20 +140,85 @@ public:
   Font& operator=(Font&&) = delete;
      
   /**
-   * @brief Constructs a font from a `.scrollerfont` font file.
+   * @brief Constructs a font from a `.scrollerfont` font file, which may be
+   *        a raw font or a font container (see `FontFile`).
+   * 
+   * The file is mapped only while the glyphs are copied out of it.
    * 
    * @param font_file_name name of the font file to read font data from
    * @param proportional whether to create `Glyph`s with excess whitespace
    *                     removed from both sides of the glyphs
    * @param spacing number of blank columns of spacing to include at the end
    *                of each glyph
+   * 
+   * @throws std::runtime_error if the font file cannot be opened or mapped
+   *         or is not a valid font file
    */
   Font(std::string font_file_name, bool proportional, std::size_t spacing);
 
   /**
-   * @brief `Font` destructor.
+   * @brief Constructs a font from a font file that is already mapped into
+   *        memory, so that fonts with different settings can be built from
+   *        it without mapping the file again.
+   * 
+   * The glyphs are copied out of the mapping, so the font does not need the
+   * font file once it is constructed.
+   * 
+   * @param font_file mapped raw font or font container
+   * @param proportional whether to create `Glyph`s with excess whitespace
+   *                     removed from both sides of the glyphs
+   * @param spacing number of blank columns of spacing to include at the end
+   *                of each glyph
    */
-  ~Font();
+  Font(const FontFile& font_file, bool proportional, std::size_t spacing);
+
+  /**
+   * @brief Constructs a font from glyph data that is already in memory, such
+   *        as a font table generated into `include/fonts/` at build time.
+   * 
+   * @param font_data glyph data laid out like a `.scrollerfont` file
+   * @param proportional whether to create `Glyph`s with excess whitespace
+   *                     removed from both sides of the glyphs
+   * @param spacing number of blank columns of spacing to include at the end
+   *                of each glyph
+   */
+  Font(const std::uint8_t (&font_data)[FONT_DATA_SIZE], bool proportional,
+       std::size_t spacing);
+
+  /**
+   * @brief Returns whether glyphs are drawn with excess whitespace removed.
+   * 
+   * @return `true` if the font is proportional
+   */
+  bool is_proportional() const;
+
+  /**
+   * @brief Sets whether glyphs are drawn with excess whitespace removed;
+   *        only the pre-shifted glyphs are rebuilt, since the metrics of the
+   *        glyphs do not depend on it.
+   * 
+   * @param proportional whether to draw glyphs with excess whitespace
+   *                     removed from both sides of the glyphs
+   */
+  void set_proportional(bool proportional);
+
+  /**
+   * @brief Returns the number of blank columns drawn at the end of each
+   *        glyph.
+   * 
+   * @return spacing of the font in pixels
+   */
+  std::size_t get_spacing() const;
+
+  /**
+   * @brief Sets the number of blank columns drawn at the end of each glyph;
+   *        only the pre-shifted glyphs are rebuilt, since the metrics of the
+   *        glyphs do not depend on it.
+   * 
+   * @param spacing number of blank columns of spacing to include at the end
+   *                of each glyph
+   */
+  void set_spacing(std::size_t spacing);
 
   /**
    * @brief Returns the width of the `Glyph` with the specified UTF-8 code
@@ -75,7 +231,7 @@ public:
 
   /**
    * @brief Returns the specified pixel of the glyph with the specified UTF-8
-   *        code point.
+   *        code point as it is drawn.
    * 
    * @param code_point code point of the desired glyph
    * @param r row of the glyph of the desired pixel
@@ -86,22 +242,76 @@ public:
   std::uint_fast8_t get_pixel(std::uint_fast8_t code_point, std::size_t row,
                               std::size_t col);
 
+  /**
+   * @brief Returns the rows of the glyph with the specified UTF-8 code point
+   *        pre-shifted to start at the specified bit offset.
+   * 
+   * @param code_point code point of the desired glyph
+   * @param bit_offset column within a matrix at which the glyph starts
+   * @return pre-shifted glyph rows and column masks
+   */
+  const ShiftedGlyph& get_shifted_glyph(std::uint_fast8_t code_point,
+                                        std::size_t bit_offset) const;
+
+private:
+
+  /**
+   * @brief Creates the glyphs of this font from glyph data laid out like a
+   *        `.scrollerfont` file, computing their metrics from the data.
+   * 
+   * @param font_data glyph data of all of the glyphs in the font
+   */
+  void load_glyphs(const std::uint8_t* font_data);
+
+  /**
+   * @brief Creates the glyphs of this font from a mapped font file, using
+   *        the metrics stored in it when it is a font container.
+   * 
+   * @param font_file mapped raw font or font container
+   */
+  void load_glyphs(const FontFile& font_file);
+
+  /**
+   * @brief Fills `shifted_glyphs` from the glyphs of this font and its
+   *        current proportional mode and spacing.
+   */
+  void build_shifted_glyphs();
+
 };  // class Font
 
-inline Font::~Font() {
-  for (std::size_t i = 0; i < font_glyphs.size(); i++) {
-    delete font_glyphs.at(i);
-  }
+inline bool Font::is_proportional() const {
+  return proportional;
+}
+
+inline void Font::set_proportional(bool proportional) {
+  this->proportional = proportional;
+  build_shifted_glyphs();
+}
+
+inline std::size_t Font::get_spacing() const {
+  return spacing;
+}
+
+inline void Font::set_spacing(std::size_t spacing) {
+  this->spacing = spacing;
+  build_shifted_glyphs();
 }
 
 inline std::uint_fast8_t Font::get_pixel(std::uint_fast8_t code_point,
                                          std::size_t row, std::size_t col) {
 
-  return font_glyphs.at(code_point)->get_pixel(row, col);
+  return !!(font_glyphs.at(code_point).get_drawn_row(row, proportional)
+            & (1 << (Glyph::WIDTH_MAX - 1 - col)));
 }
 
 inline std::size_t Font::get_glyph_width(std::uint_fast8_t code_point) {
-  return font_glyphs.at(code_point)->get_width();
+  return font_glyphs.at(code_point).get_width(proportional, spacing);
+}
+
+inline const Font::ShiftedGlyph& Font::get_shifted_glyph(
+    std::uint_fast8_t code_point, std::size_t bit_offset) const {
+
+  return shifted_glyphs[code_point & 0xFF][bit_offset % BIT_OFFSET_COUNT];
 }
 
 #endif  // SCROLLER_FONT_H_
@@ -0,0 +1,272 @@
+/**
+ * @file FontFile.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FONT_FILE_H_
+#define SCROLLER_FONT_FILE_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief A font file mapped read-only into memory.
+ *
+ * Two formats are accepted. A raw font is exactly 2048 bytes: 8 rows for
+ * each of the 256 code points. A font container starts with a header that
+ * describes the glyphs and holds their precomputed metrics, followed by the
+ * glyph data. All multi-byte values are little-endian.
+ *
+ * ```
+ * offset        size  contents
+ * 0             4     magic "SCRF"
+ * 4             2     format version (1 or 2)
+ * 6             2     glyph count n (1 to 256)
+ * 8             1     glyph height in rows (8)
+ * 9             3     reserved (0)
+ * 12            n     advance: width of each glyph with excess whitespace
+ *                     removed, before the spacing of the font is added
+ * 12 + n        n     left bearing: blank columns to the left of each glyph
+ * 12 + 2n       n     flags of each glyph (see `Glyph::FIXED_ADVANCE`)
+ * 12 + 3n       8n    glyph data, 8 rows per glyph, ordered by code point
+ * ```
+ *
+ * Version 1 containers have no flags table, so their glyph data starts at
+ * 12 + 2n; `Font` gives their blank glyphs the flags it gives those of raw
+ * fonts.
+ *
+ * The file is mapped rather than read, so it is validated and read in place
+ * without being copied into a buffer first. A `Font` does copy the glyphs
+ * out of the mapping, into its own glyph table and pre-shifted glyph cache,
+ * since those are what drawing reads; the mapping is only needed while
+ * fonts are built from it and is released when the `FontFile` is destroyed.
+ */
+class FontFile {
+
+public:
+
+  /**
+   * Bytes that identify a font container.
+   */
+  static constexpr char MAGIC[4]{'S', 'C', 'R', 'F'};
+
+  /**
+   * Version of the font container format written by `invoke convert-font`.
+   */
+  static const std::uint16_t VERSION{2};
+
+  /**
+   * Version of the font container format that stores no glyph flags.
+   */
+  static const std::uint16_t UNFLAGGED_VERSION{1};
+
+  /**
+   * Size in bytes of the fixed part of the container header.
+   */
+  static const std::size_t HEADER_SIZE{12};
+
+  /**
+   * Number of rows of every glyph.
+   */
+  static const std::size_t GLYPH_HEIGHT{8};
+
+  /**
+   * Number of columns of every glyph.
+   */
+  static const std::size_t GLYPH_WIDTH{8};
+
+  /**
+   * Maximum number of glyphs in a font; also the glyph count of a raw font.
+   */
+  static const std::size_t MAX_GLYPH_COUNT{256};
+
+  /**
+   * Size in bytes of a raw font.
+   */
+  static const std::size_t RAW_SIZE{MAX_GLYPH_COUNT * GLYPH_HEIGHT};
+
+private:
+
+  /**
+   * Path of the mapped file, used in error messages.
+   */
+  const std::string path;
+
+  /**
+   * Start of the mapping.
+   */
+  const std::uint8_t* data;
+
+  /**
+   * Size of the mapping in bytes.
+   */
+  std::size_t size;
+
+  /**
+   * Whether the file is a raw font rather than a font container.
+   */
+  bool raw;
+
+  /**
+   * Number of glyphs held by the file.
+   */
+  std::size_t glyph_count;
+
+  /**
+   * Advances of the glyphs; `nullptr` for a raw font.
+   */
+  const std::uint8_t* advances;
+
+  /**
+   * Left bearings of the glyphs; `nullptr` for a raw font.
+   */
+  const std::uint8_t* left_bearings;
+
+  /**
+   * Flags of the glyphs; `nullptr` for a raw font or a version 1 container.
+   */
+  const std::uint8_t* glyph_flags;
+
+  /**
+   * Rows of all of the glyphs.
+   */
+  const std::uint8_t* glyph_rows;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FontFile(const FontFile&) = delete;
+  FontFile(FontFile&&) = delete;
+  FontFile& operator=(const FontFile&) = delete;
+  FontFile& operator=(FontFile&&) = delete;
+
+  /**
+   * @brief Maps a font file into memory and validates it.
+   *
+   * @param path path of the raw font or font container
+   *
+   * @throws std::runtime_error if the file cannot be opened or mapped, or if
+   *         it is neither a raw font nor a valid font container
+   */
+  FontFile(const std::string& path);
+
+  /**
+   * @brief Unmaps the font file.
+   */
+  ~FontFile();
+
+  /**
+   * @brief Returns whether the file is a raw font, which holds no metrics.
+   *
+   * @return `true` for a raw font, `false` for a font container
+   */
+  bool is_raw() const;
+
+  /**
+   * @brief Returns whether the file stores the flags of its glyphs, which
+   *        only version 2 font containers do.
+   *
+   * @return `true` if glyph flags are stored
+   */
+  bool has_flags() const;
+
+  /**
+   * @brief Returns the number of glyphs held by the file; code points at and
+   *        beyond this number have no glyph.
+   *
+   * @return glyph count
+   */
+  std::size_t get_glyph_count() const;
+
+  /**
+   * @brief Returns the rows of a glyph directly from the mapping.
+   *
+   * @param code_point code point of the glyph; must be less than the glyph
+   *                   count
+   * @return pointer to `GLYPH_HEIGHT` rows
+   */
+  const std::uint8_t* get_glyph_rows(std::size_t code_point) const;
+
+  /**
+   * @brief Returns the width of a glyph with excess whitespace removed, as
+   *        stored in the container header.
+   *
+   * @param code_point code point of the glyph; must be less than the glyph
+   *                   count of a font container
+   * @return advance of the glyph in pixels
+   */
+  std::size_t get_advance(std::size_t code_point) const;
+
+  /**
+   * @brief Returns the number of blank columns to the left of a glyph, as
+   *        stored in the container header.
+   *
+   * @param code_point code point of the glyph; must be less than the glyph
+   *                   count of a font container
+   * @return left bearing of the glyph in pixels
+   */
+  std::size_t get_left_bearing(std::size_t code_point) const;
+
+  /**
+   * @brief Returns the flags of a glyph, as stored in the container header.
+   *
+   * @param code_point code point of the glyph; must be less than the glyph
+   *                   count of a font container
+   * @return flags of the glyph; `0` if the file stores no flags
+   */
+  std::uint_fast8_t get_flags(std::size_t code_point) const;
+
+private:
+
+  /**
+   * @brief Validates the container header and locates the tables that
+   *        follow it.
+   */
+  void parse_container();
+
+  /**
+   * @brief Unmaps the file and throws an exception describing a problem
+   *        with it.
+   *
+   * @param line source line at which the problem was found
+   * @param message description of the problem
+   */
+  [[noreturn]] void fail(int line, const std::string& message);
+
+};  // class FontFile
+
+inline bool FontFile::is_raw() const {
+  return raw;
+}
+
+inline bool FontFile::has_flags() const {
+  return glyph_flags != nullptr;
+}
+
+inline std::size_t FontFile::get_glyph_count() const {
+  return glyph_count;
+}
+
+inline const std::uint8_t* FontFile::get_glyph_rows(
+    std::size_t code_point) const {
+
+  return glyph_rows + code_point * GLYPH_HEIGHT;
+}
+
+inline std::size_t FontFile::get_advance(std::size_t code_point) const {
+  return advances[code_point];
+}
+
+inline std::size_t FontFile::get_left_bearing(std::size_t code_point) const {
+  return left_bearings[code_point];
+}
+
+inline std::uint_fast8_t FontFile::get_flags(std::size_t code_point) const {
+  return glyph_flags != nullptr ? glyph_flags[code_point] : 0;
+}
+
+#endif  // SCROLLER_FONT_FILE_H_
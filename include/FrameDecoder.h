@@ -0,0 +1,232 @@
+/**
+ * @file FrameDecoder.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_DECODER_H_
+#define SCROLLER_FRAME_DECODER_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "FrameFile.h"
+
+/**
+ * @brief Reads the frames of a frame file in order, decoding each one into
+ *        a single reusable buffer of row data.
+ *
+ * Encoded frames are described in terms of the frame before them, so the
+ * decoder keeps the most recent frame and applies each record to it. Moving
+ * forward decodes only the records in between; moving backward starts over
+ * from the first frame. The decoder also reports which rows changed, so that
+ * frames that repeat the previous one need not be sent at all.
+ *
+ * ```
+ * FrameDecoder decoder{file};
+ * for (std::size_t frame = 0; frame < file.get_frame_count(); frame++) {
+ *   decoder.seek(frame);
+ *   if (decoder.get_changed_rows() != 0) {
+ *     device.display(decoder);
+ *   }
+ * }
+ * ```
+ */
+class FrameDecoder {
+
+public:
+
+  /**
+   * Value of `get_changed_rows()` when every row may have changed.
+   */
+  static const std::uint8_t ALL_ROWS{0xFF};
+
+private:
+
+  /**
+   * File that the frames are read from.
+   */
+  const FrameFile& file;
+
+  /**
+   * Row data of the most recently decoded frame.
+   */
+  std::vector<std::uint8_t> rows;
+
+  /**
+   * Index of the next frame to decode.
+   */
+  std::size_t next_frame;
+
+  /**
+   * Start of the next frame to decode within the mapping.
+   */
+  const std::uint8_t* next_record;
+
+  /**
+   * Rows that changed during the most recent call to `seek()`.
+   */
+  std::uint8_t changed_rows;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameDecoder(const FrameDecoder&) = delete;
+  FrameDecoder(FrameDecoder&&) = delete;
+  FrameDecoder& operator=(const FrameDecoder&) = delete;
+  FrameDecoder& operator=(FrameDecoder&&) = delete;
+
+  /**
+   * @brief Constructs a decoder positioned before the first frame of a file.
+   *
+   * @param file file to read the frames from; must outlive the decoder
+   */
+  FrameDecoder(const FrameFile& file);
+
+  /**
+   * @brief Returns the file that the frames are read from.
+   *
+   * @return frame file
+   */
+  const FrameFile& get_file() const;
+
+  /**
+   * @brief Decodes the frames up to and including the specified frame.
+   *
+   * @param frame index of the frame to decode
+   *
+   * @throws std::out_of_range if there is no frame with the specified index
+   */
+  void seek(std::size_t frame);
+
+  /**
+   * @brief Returns the row data of the most recently decoded frame, stored
+   *        like the frames of a `FrameStore`.
+   *
+   * @return row data, `get_file().get_frame_size()` bytes long
+   */
+  const std::uint8_t* get_rows() const;
+
+  /**
+   * @brief Returns the rows that changed during the most recent call to
+   *        `seek()`; every row is reported as changed after the decoder
+   *        starts over from the first frame, since it cannot know what was
+   *        displayed before.
+   *
+   * @return mask of the rows that changed, with bit `r` set for row `r`
+   */
+  std::uint8_t get_changed_rows() const;
+
+  /**
+   * @brief Shifts the columns of a frame as a `SHIFT` frame does (see
+   *        `FrameFile`).
+   *
+   * @param rows row data of the frame to shift in place
+   * @param length number of matrices in the chain
+   * @param matrix_orientation orientation that the frame was recorded for
+   * @param shift number of columns to shift toward the first byte of the
+   *              row data (positive) or toward the last byte (negative); at
+   *              most `8` either way
+   * @param incoming 8 bytes holding the columns shifted in
+   */
+  static void shift_frame(std::uint8_t* rows, std::size_t length,
+                          std::size_t matrix_orientation, int shift,
+                          const std::uint8_t* incoming);
+
+  /**
+   * @brief Takes from a frame the columns that a `SHIFT` frame would have
+   *        shifted in to produce it.
+   *
+   * @param rows row data of the frame
+   * @param length number of matrices in the chain
+   * @param matrix_orientation orientation that the frame was recorded for
+   * @param shift number of columns shifted, as for `shift_frame()`
+   * @param incoming 8 bytes to store the columns shifted in
+   */
+  static void get_incoming_columns(const std::uint8_t* rows,
+                                   std::size_t length,
+                                   std::size_t matrix_orientation, int shift,
+                                   std::uint8_t* incoming);
+
+private:
+
+  /**
+   * @brief Moves the decoder back to before the first frame with a blank
+   *        frame as the frame before it.
+   */
+  void rewind();
+
+  /**
+   * @brief Decodes the next frame and adds the rows that it changed to
+   *        `changed_rows`.
+   */
+  void decode_next();
+
+  /**
+   * @brief Shifts the bits of a row of a frame recorded for orientation 0
+   *        or 2.
+   *
+   * @param row row data to shift in place
+   * @param length number of bytes in the row
+   * @param shift number of bits to shift, as for `shift_frame()`
+   * @param incoming byte holding the bits shifted in at the positions that
+   *                 they are shifted into; its other bits are ignored
+   * @param reversed whether the columns start from the least-significant
+   *                 bit of each byte (orientation 2) rather than the most
+   */
+  static void shift_row(std::uint8_t* row, std::size_t length, int shift,
+                        std::uint8_t incoming, bool reversed);
+
+  /**
+   * @brief Shifts the row bytes of a frame recorded for orientation 1 or 3.
+   *
+   * @param rows row data of the frame to shift in place
+   * @param length number of matrices in the chain
+   * @param shift number of bytes to shift, as for `shift_frame()`
+   * @param incoming bytes shifted in
+   * @param reversed whether the columns start from row 7 of each matrix
+   *                 (orientation 3) rather than row 0
+   */
+  static void shift_columns(std::uint8_t* rows, std::size_t length,
+                            int shift, const std::uint8_t* incoming,
+                            bool reversed);
+
+  /**
+   * @brief Returns the position of a column of a frame recorded for
+   *        orientation 1 or 3 within its row data.
+   *
+   * @param column index of the column, counted across the whole chain
+   * @param length number of matrices in the chain
+   * @param reversed as for `shift_columns()`
+   * @return index of the row byte that holds the column
+   */
+  static std::size_t get_column_index(std::size_t column, std::size_t length,
+                                      bool reversed);
+
+  /**
+   * @brief Replaces a row of the decoded frame and records whether it
+   *        changed.
+   *
+   * @param row index of the row
+   * @param data new data for the row
+   */
+  void replace_row(std::size_t row, const std::uint8_t* data);
+
+};  // class FrameDecoder
+
+inline const FrameFile& FrameDecoder::get_file() const {
+  return file;
+}
+
+inline const std::uint8_t* FrameDecoder::get_rows() const {
+  return rows.data();
+}
+
+inline std::uint8_t FrameDecoder::get_changed_rows() const {
+  return changed_rows;
+}
+
+#endif  // SCROLLER_FRAME_DECODER_H_
@@ -0,0 +1,401 @@
+/**
+ * @file FrameFile.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_FILE_H_
+#define SCROLLER_FRAME_FILE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "MatrixImage.h"
+
+/**
+ * @brief A file of pre-rendered frames mapped read-only into memory.
+ *
+ * A frame file is written by `FrameFileWriter` for a chain of a specific
+ * length and orientation, and holds the frames in the same form as a
+ * `FrameStore`: the row data latched into the chain, `8 * length` bytes per
+ * frame stored row-major, already oriented for the device. All multi-byte
+ * values are little-endian.
+ *
+ * ```
+ * offset  size  contents
+ * 0       4     magic "SCFR"
+ * 4       2     format version (1 or 2)
+ * 6       1     matrix orientation of the chain (0 to 3)
+ * 7       1     flags (bit 0: chain is upside down, bit 1: chain has a
+ *               module transform table)
+ * 8       4     chain length in matrices
+ * 12      4     frame count
+ * 16      8     frame period in nanoseconds
+ * 24      8     module transform table of the chain, only if flag bit 1 is
+ *               set (see `MAX7219Chain::get_transform_table_id()`)
+ * 24/32   ...   frames, one after another
+ * ```
+ *
+ * A file recorded for a chain with a module transform table sets the flag
+ * that older readers reject, so they cannot play its frames scrambled.
+ *
+ * In version 1 every frame is its row data in full. In version 2 every frame
+ * is a record that starts with its `Encoding` and describes the frame in
+ * terms of the frame before it, which is blank for the first frame; frames
+ * are read in order with a `FrameDecoder`.
+ *
+ * ```
+ * encoding  payload
+ * KEYFRAME  row data of the frame, 8 * length bytes
+ * DELTA     mask of the rows that changed (bit r for row r), then the data
+ *           of each of those rows, length bytes per row
+ * REPEAT    none; the frame is the same as the frame before it
+ * SHIFT     signed number of columns n (1 to 7 or -1 to -7), then 8 bytes
+ *           holding the columns that are shifted in
+ * ```
+ *
+ * A `SHIFT` frame moves every column of the frame before it by n columns,
+ * toward the first byte of the row data for a positive n. Columns are read
+ * through the matrices from the first to the last. In orientations 0 and 2
+ * they are the bits of each row, starting from the most-significant bit of
+ * each byte in orientation 0 and the least-significant bit in orientation 2,
+ * and the 8 bytes are the first byte (for a negative n) or last byte (for a
+ * positive n) of each row, of which only the bits shifted in are used. In
+ * orientations 1 and 3 they are the row bytes, starting from row 0 of each
+ * matrix in orientation 1 and row 7 in orientation 3, and the first n of the
+ * 8 bytes are the columns shifted in, in order.
+ *
+ * The mapping is advised for sequential access, so the kernel reads ahead
+ * while frames are played and drops pages that have been played, and a loop
+ * that is played every day is shared through the page cache.
+ */
+class FrameFile {
+
+  /**
+   * Decoders read the frames directly from the mapping.
+   */
+  friend class FrameDecoder;
+
+public:
+
+  /**
+   * How a frame of a version 2 file is stored.
+   */
+  enum class Encoding : std::uint8_t {
+
+    /**
+     * The row data of the frame in full.
+     */
+    KEYFRAME = 0,
+
+    /**
+     * The rows of the frame that differ from the frame before it.
+     */
+    DELTA = 1,
+
+    /**
+     * Nothing; the frame is the same as the frame before it.
+     */
+    REPEAT = 2,
+
+    /**
+     * The columns of the frame before it shifted by a few columns, with new
+     * columns shifted in.
+     */
+    SHIFT = 3,
+
+  };
+
+  /**
+   * Bytes that identify a frame file.
+   */
+  static constexpr char MAGIC[4]{'S', 'C', 'F', 'R'};
+
+  /**
+   * Version of the frame file format written by `FrameFileWriter`.
+   */
+  static const std::uint16_t VERSION{2};
+
+  /**
+   * Version of the frame file format in which every frame is stored in full.
+   */
+  static const std::uint16_t RAW_VERSION{1};
+
+  /**
+   * Largest number of columns by which a `SHIFT` frame shifts its rows.
+   */
+  static const std::size_t MAX_SHIFT{7};
+
+  /**
+   * Size in bytes of the header that precedes the frames.
+   */
+  static const std::size_t HEADER_SIZE{24};
+
+  /**
+   * Flag marking a file recorded for a chain that is upside down.
+   */
+  static const std::uint8_t UPSIDE_DOWN{0x01};
+
+  /**
+   * Flag marking a file recorded for a chain with a module transform table,
+   * whose identifier follows the header.
+   */
+  static const std::uint8_t TRANSFORM_TABLE{0x02};
+
+  /**
+   * Size in bytes of the module transform table identifier.
+   */
+  static const std::size_t TRANSFORM_TABLE_SIZE{8};
+
+private:
+
+  /**
+   * Path of the mapped file, used in error messages.
+   */
+  const std::string path;
+
+  /**
+   * Start of the mapping.
+   */
+  const std::uint8_t* data;
+
+  /**
+   * Size of the mapping in bytes.
+   */
+  std::size_t size;
+
+  /**
+   * Format version of the file.
+   */
+  std::uint16_t version;
+
+  /**
+   * Number of matrices in the chain that the frames were recorded for.
+   */
+  std::size_t length;
+
+  /**
+   * Matrix orientation of the chain that the frames were recorded for.
+   */
+  std::size_t matrix_orientation;
+
+  /**
+   * Whether the chain that the frames were recorded for is upside down.
+   */
+  bool upside_down;
+
+  /**
+   * Module transform table of the chain that the frames were recorded for;
+   * `0` for a chain with a single orientation.
+   */
+  std::uint64_t transform_table_id;
+
+  /**
+   * Number of frames in the file.
+   */
+  std::size_t frame_count;
+
+  /**
+   * Time for which each frame is displayed.
+   */
+  std::chrono::nanoseconds frame_period;
+
+  /**
+   * Start of the first frame.
+   */
+  const std::uint8_t* frames;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameFile(const FrameFile&) = delete;
+  FrameFile(FrameFile&&) = delete;
+  FrameFile& operator=(const FrameFile&) = delete;
+  FrameFile& operator=(FrameFile&&) = delete;
+
+  /**
+   * @brief Maps a frame file into memory and validates it.
+   *
+   * @param path path of the frame file
+   *
+   * @throws std::runtime_error if the file cannot be opened or mapped, or if
+   *         it is not a valid frame file
+   */
+  FrameFile(const std::string& path);
+
+  /**
+   * @brief Unmaps the frame file.
+   */
+  ~FrameFile();
+
+  /**
+   * @brief Returns whether the frames are stored as encoded records (version
+   *        2) rather than in full (version 1).
+   *
+   * @return `true` if the frames are encoded
+   */
+  bool is_encoded() const;
+
+  /**
+   * @brief Returns the size of the file in bytes.
+   *
+   * @return file size in bytes
+   */
+  std::size_t get_file_size() const;
+
+  /**
+   * @brief Returns the number of matrices in the chain that the frames were
+   *        recorded for.
+   *
+   * @return chain length in matrices
+   */
+  std::size_t get_length() const;
+
+  /**
+   * @brief Returns the matrix orientation of the chain that the frames were
+   *        recorded for.
+   *
+   * @return number of 90 degree clockwise rotations of each matrix
+   */
+  std::size_t get_matrix_orientation() const;
+
+  /**
+   * @brief Returns whether the chain that the frames were recorded for is
+   *        upside down.
+   *
+   * @return `true` if the chain is upside down
+   */
+  bool is_upside_down() const;
+
+  /**
+   * @brief Returns the module transform table of the chain that the frames
+   *        were recorded for.
+   *
+   * @return transform table identifier; `0` for a chain with a single
+   *         orientation
+   */
+  std::uint64_t get_transform_table_id() const;
+
+  /**
+   * @brief Returns the number of frames in the file.
+   *
+   * @return frame count
+   */
+  std::size_t get_frame_count() const;
+
+  /**
+   * @brief Returns the number of bytes in each frame.
+   *
+   * @return size of a frame in bytes
+   */
+  std::size_t get_frame_size() const;
+
+  /**
+   * @brief Returns the time for which each frame is displayed.
+   *
+   * @return frame period
+   */
+  std::chrono::nanoseconds get_frame_period() const;
+
+  /**
+   * @brief Returns the size in bytes of the payload of an encoded frame.
+   *
+   * @param encoding encoding of the frame
+   * @param length chain length in matrices
+   * @param row_mask mask of the rows stored by a `DELTA` frame
+   * @return payload size in bytes, not including the encoding byte
+   */
+  static std::size_t get_payload_size(Encoding encoding, std::size_t length,
+                                      std::uint8_t row_mask = 0);
+
+private:
+
+  /**
+   * @brief Validates the header and locates the frames that follow it.
+   */
+  void parse_header();
+
+  /**
+   * @brief Checks that the records of an encoded file are well formed, that
+   *        there is one record for each frame, and that they fill the rest
+   *        of the file exactly, so that decoding never reads past the end of
+   *        the mapping.
+   */
+  void validate_records();
+
+  /**
+   * @brief Reads a little-endian value from the mapping.
+   *
+   * @param offset position of the value within the file
+   * @param byte_count number of bytes in the value
+   * @return value read
+   */
+  std::uint64_t read_value(std::size_t offset, std::size_t byte_count) const;
+
+  /**
+   * @brief Unmaps the file and throws an exception describing a problem
+   *        with it.
+   *
+   * @param line source line at which the problem was found
+   * @param message description of the problem
+   */
+  [[noreturn]] void fail(int line, const std::string& message);
+
+};  // class FrameFile
+
+inline bool FrameFile::is_encoded() const {
+  return version != RAW_VERSION;
+}
+
+inline std::size_t FrameFile::get_file_size() const {
+  return size;
+}
+
+inline std::size_t FrameFile::get_length() const {
+  return length;
+}
+
+inline std::size_t FrameFile::get_matrix_orientation() const {
+  return matrix_orientation;
+}
+
+inline bool FrameFile::is_upside_down() const {
+  return upside_down;
+}
+
+inline std::uint64_t FrameFile::get_transform_table_id() const {
+  return transform_table_id;
+}
+
+inline std::size_t FrameFile::get_frame_count() const {
+  return frame_count;
+}
+
+inline std::size_t FrameFile::get_frame_size() const {
+  return MatrixImage::HEIGHT * length;
+}
+
+inline std::chrono::nanoseconds FrameFile::get_frame_period() const {
+  return frame_period;
+}
+
+inline std::size_t FrameFile::get_payload_size(Encoding encoding,
+                                              std::size_t length,
+                                              std::uint8_t row_mask) {
+  switch (encoding) {
+    case Encoding::KEYFRAME:
+      return MatrixImage::HEIGHT * length;
+    case Encoding::DELTA:
+      return 1 + __builtin_popcount(row_mask) * length;
+    case Encoding::SHIFT:
+      return 1 + MatrixImage::HEIGHT;
+    default:
+      return 0;
+  }
+}
+
+#endif  // SCROLLER_FRAME_FILE_H_
@@ -0,0 +1,188 @@
+/**
+ * @file FrameFileWriter.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_FILE_WRITER_H_
+#define SCROLLER_FRAME_FILE_WRITER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MAX7219Chain.h"
+#include "ChainImageView.h"
+#include "FrameStore.h"
+
+/**
+ * @brief Renders frames for a chain and writes them to a frame file (see
+ *        `FrameFile`) so that they can be played back later without being
+ *        rendered again.
+ *
+ * Frames are rendered with `MAX7219Chain::record_frame()`, which applies the
+ * chain's orientation exactly as displaying them would, and are written as
+ * they are rendered, so a long loop never has to be held in memory. Each frame
+ * is compared with the frame before it and stored with whichever encoding of
+ * `FrameFile::Encoding` takes the fewest bytes, so a frame that repeats the
+ * last one costs a single byte and a scrolling frame costs ten.
+ *
+ * ```
+ * FrameFileWriter writer{"loop.frames", device,
+ *                        std::chrono::milliseconds{100}};
+ * for (source.set_frame(0); !source.is_finished(); source.next_frame()) {
+ *   writer.write_frame(source.get_frame());
+ * }
+ * writer.close();
+ * ```
+ */
+class FrameFileWriter {
+
+private:
+
+  /**
+   * Path of the file being written, used in error messages.
+   */
+  const std::string path;
+
+  /**
+   * Chain that the frames are rendered for.
+   */
+  const MAX7219Chain& device;
+
+  /**
+   * File being written.
+   */
+  std::ofstream file;
+
+  /**
+   * Preallocated store that holds the frame being written.
+   */
+  FrameStore frame;
+
+  /**
+   * Row data of the frame written before the frame being written, blank
+   * before the first frame.
+   */
+  std::vector<std::uint8_t> previous_rows;
+
+  /**
+   * Preallocated buffer that holds the record of the frame being written.
+   */
+  std::vector<std::uint8_t> record;
+
+  /**
+   * Preallocated buffer that holds the frame before the frame being written
+   * while a shift is tried on it.
+   */
+  std::vector<std::uint8_t> shifted_rows;
+
+  /**
+   * Number of frames written so far.
+   */
+  std::size_t frame_count;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameFileWriter(const FrameFileWriter&) = delete;
+  FrameFileWriter(FrameFileWriter&&) = delete;
+  FrameFileWriter& operator=(const FrameFileWriter&) = delete;
+  FrameFileWriter& operator=(FrameFileWriter&&) = delete;
+
+  /**
+   * @brief Creates a frame file, replacing any file at the same path, and
+   *        writes its header.
+   *
+   * @param path path of the frame file
+   * @param device chain that the frames are rendered for; must outlive the
+   *               writer
+   * @param frame_period time for which each frame is displayed
+   *
+   * @throws std::runtime_error if the file cannot be written
+   * @throws std::invalid_argument if the frame period is not positive
+   */
+  FrameFileWriter(const std::string& path, const MAX7219Chain& device,
+                  std::chrono::nanoseconds frame_period);
+
+  /**
+   * @brief Completes the file if `close()` has not been called; errors are
+   *        ignored, so call `close()` to find out whether the file is valid.
+   */
+  ~FrameFileWriter();
+
+  /**
+   * @brief Renders a view of an image for the chain and appends it to the
+   *        file.
+   *
+   * @param view view of the image to write
+   *
+   * @throws std::runtime_error if the frame cannot be written
+   */
+  void write_frame(const ChainImageView& view);
+
+  /**
+   * @brief Returns the number of frames written so far.
+   *
+   * @return frame count
+   */
+  std::size_t get_frame_count() const;
+
+  /**
+   * @brief Writes the final frame count into the header and closes the
+   *        file; does nothing if the file is already closed.
+   *
+   * @throws std::runtime_error if the file cannot be completed
+   */
+  void close();
+
+private:
+
+  /**
+   * @brief Encodes the frame being written against the frame before it into
+   *        `record`, choosing the encoding that takes the fewest bytes.
+   *
+   * @param rows row data of the frame being written
+   */
+  void encode_frame(const std::uint8_t* rows);
+
+  /**
+   * @brief Tries to describe the frame being written as the frame before it
+   *        shifted by a number of columns, and encodes it into `record` if
+   *        it can be.
+   *
+   * @param rows row data of the frame being written
+   * @param shift number of columns to try, as for
+   *              `FrameDecoder::shift_frame()`
+   * @return `true` if the frame was encoded as a `SHIFT` frame
+   */
+  bool encode_shift(const std::uint8_t* rows, int shift);
+
+  /**
+   * @brief Writes a value to the file in little-endian byte order.
+   *
+   * @param value value to write
+   * @param byte_count number of bytes to write
+   */
+  void write_value(std::uint64_t value, std::size_t byte_count);
+
+  /**
+   * @brief Throws an exception if the last operation on the file failed.
+   *
+   * @param line source line of the operation
+   * @param message description of the operation
+   */
+  void check_file(int line, const std::string& message);
+
+};  // class FrameFileWriter
+
+inline std::size_t FrameFileWriter::get_frame_count() const {
+  return frame_count;
+}
+
+#endif  // SCROLLER_FRAME_FILE_WRITER_H_
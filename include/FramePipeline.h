@@ -0,0 +1,226 @@
+/**
+ * @file FramePipeline.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_PIPELINE_H_
+#define SCROLLER_FRAME_PIPELINE_H_
+
+#include <cstdint>
+
+#include "MAX7219Chain.h"
+#include "MatrixChainImage.h"
+#include "FrameSource.h"
+#include "FrameStore.h"
+#include "FrameRing.h"
+#include "FrameScheduler.h"
+
+/**
+ * @brief Displays the frames of a source on a chain with rendering,
+ *        serialization and transmission running on separate threads.
+ *
+ * Each frame passes through three stages: the render stage produces the
+ * frame from the source and copies it into a preallocated image, the
+ * serialize stage orients it for the chain and packs it into row data with
+ * `MAX7219Chain::record_frame()`, and the transmit stage sends the rows that
+ * changed to the device. The stages are connected by `FrameRing`s, so while
+ * one frame is being sent the next ones are already being serialized and
+ * rendered, and frames are displayed as fast as the slowest stage rather
+ * than as fast as all three in turn. The stages never drop frames: a stage
+ * waits whenever the stage after it falls behind. Passing a frame takes no
+ * lock while neither stage is waiting, but a stage that has waited for more
+ * than a moment sleeps on a mutex and condition variable rather than
+ * spinning, so that the stages ahead of a slow transmit stage leave the CPU
+ * to it.
+ *
+ * Given a `FrameScheduler`, the transmit stage sends each frame at its
+ * deadline, so the source plays at the scheduler's frame rate, and with the
+ * `SKIP` policy drops frames that are already late; otherwise frames are
+ * sent as soon as they are ready.
+ *
+ * ```
+ * TextFrameSource source{text, font, device.get_length()};
+ * FrameScheduler scheduler{10.0};
+ * FramePipeline pipeline{device, source};
+ * pipeline.run(scheduler);
+ * ```
+ */
+class FramePipeline {
+
+public:
+
+  /**
+   * Default number of frames that can be queued between two stages.
+   */
+  static const std::size_t DEFAULT_CAPACITY{4};
+
+private:
+
+  /**
+   * Chain that the frames are displayed on.
+   */
+  MAX7219Chain& device;
+
+  /**
+   * Source that the frames are produced by.
+   */
+  FrameSource& source;
+
+  /**
+   * Frames passed from the render stage to the serialize stage.
+   */
+  FrameRing<MatrixChainImage> rendered_frames;
+
+  /**
+   * Frames passed from the serialize stage to the transmit stage.
+   */
+  FrameRing<FrameStore> serialized_frames;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FramePipeline(const FramePipeline&) = delete;
+  FramePipeline(FramePipeline&&) = delete;
+  FramePipeline& operator=(const FramePipeline&) = delete;
+  FramePipeline& operator=(FramePipeline&&) = delete;
+
+  /**
+   * @brief Constructs a pipeline and preallocates every frame that can be
+   *        queued between its stages.
+   *
+   * @param device chain to display the frames on; must outlive the pipeline
+   * @param source source to produce the frames; must outlive the pipeline
+   * @param capacity number of frames that can be queued between two stages
+   *
+   * @throws std::invalid_argument if the capacity is 0
+   */
+  FramePipeline(MAX7219Chain& device, FrameSource& source,
+                std::size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief Displays frames from the current frame of the source onward, as
+   *        fast as the stages can produce and send them, until the source
+   *        is finished, the frame count is reached, or `stop()` is called.
+   *
+   * The render and serialize stages run on threads started by this function
+   * and the transmit stage runs on the calling thread. The source must not
+   * be used by any other thread until this function returns; it is then
+   * positioned at the frame after the last one rendered.
+   *
+   * @param frame_count number of frames to display; `0` displays frames
+   *                    until the source is finished
+   * @return number of frames displayed
+   *
+   * @throws any exception thrown by one of the stages, after every stage has
+   *         stopped
+   * @throws std::system_error if a stage's thread cannot be started, after
+   *         any stage that was started has stopped
+   */
+  std::uint64_t run(std::uint64_t frame_count = 0);
+
+  /**
+   * @brief Displays frames like `run(frame_count)`, sending each frame when
+   *        the scheduler says it is due.
+   *
+   * The scheduler is restarted, so the first frame is sent as soon as it is
+   * ready and the frame indices of the scheduler count the frames of this
+   * run. With the `SKIP` policy, frames that the scheduler skips are
+   * rendered but dropped before they are sent, so the source keeps to
+   * wall-clock time; with `CATCH_UP`, every frame is sent.
+   *
+   * @param scheduler paces the frames; must not be used by any other thread
+   *                  until this function returns
+   * @param frame_count number of frames to render; `0` renders frames until
+   *                    the source is finished
+   * @return number of frames displayed
+   *
+   * @throws any exception thrown by one of the stages, after every stage has
+   *         stopped
+   * @throws std::system_error if a stage's thread cannot be started, after
+   *         any stage that was started has stopped
+   */
+  std::uint64_t run(FrameScheduler& scheduler, std::uint64_t frame_count = 0);
+
+  /**
+   * @brief Asks a running pipeline to stop; frames that are queued are not
+   *        displayed, though a frame that is already being sent is. May be
+   *        called from any thread.
+   */
+  void stop();
+
+  /**
+   * @brief Returns the ring between the render and serialize stages, e.g.
+   *        to monitor its queue depth while the pipeline runs.
+   *
+   * @return ring of rendered frames
+   */
+  const FrameRing<MatrixChainImage>& get_rendered_frames() const;
+
+  /**
+   * @brief Returns the ring between the serialize and transmit stages, e.g.
+   *        to monitor its queue depth while the pipeline runs.
+   *
+   * @return ring of serialized frames
+   */
+  const FrameRing<FrameStore>& get_serialized_frames() const;
+
+private:
+
+  /**
+   * @brief Runs the stages until they have all finished.
+   *
+   * @param frame_count as for `run()`
+   * @param scheduler paces the transmit stage, or `nullptr` to send frames
+   *                  as soon as they are ready
+   * @return number of frames displayed
+   */
+  std::uint64_t run_stages(std::uint64_t frame_count,
+                           FrameScheduler* scheduler);
+
+  /**
+   * @brief Produces frames from the source and passes them to the serialize
+   *        stage.
+   *
+   * @param frame_count as for `run()`
+   */
+  void render_frames(std::uint64_t frame_count);
+
+  /**
+   * @brief Orients and packs rendered frames into row data and passes them
+   *        to the transmit stage.
+   */
+  void serialize_frames();
+
+  /**
+   * @brief Sends serialized frames to the device.
+   *
+   * @param scheduler paces the frames, or `nullptr` to send them as soon as
+   *                  they are ready
+   * @return number of frames sent
+   */
+  std::uint64_t transmit_frames(FrameScheduler* scheduler);
+
+};  // class FramePipeline
+
+inline void FramePipeline::stop() {
+
+  // waiting stages wake up, and stages that are busy stop at their next wait
+  rendered_frames.cancel();
+  serialized_frames.cancel();
+}
+
+inline const FrameRing<MatrixChainImage>&
+FramePipeline::get_rendered_frames() const {
+  return rendered_frames;
+}
+
+inline const FrameRing<FrameStore>&
+FramePipeline::get_serialized_frames() const {
+  return serialized_frames;
+}
+
+#endif  // SCROLLER_FRAME_PIPELINE_H_
@@ -0,0 +1,106 @@
+/**
+ * @file FramePlayer.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_PLAYER_H_
+#define SCROLLER_FRAME_PLAYER_H_
+
+#include <cstdint>
+
+#include "MAX7219Chain.h"
+#include "FrameFile.h"
+#include "FrameDecoder.h"
+#include "FrameScheduler.h"
+
+/**
+ * @brief Plays the frames of a frame file on a chain at the frame period
+ *        stored in the file.
+ *
+ * Frames are decoded straight from the mapping of the file, so playing a loop
+ * that was rendered offline takes no rendering at all: each frame is decoded
+ * from the frame before it into a single buffer, copied into the chain's
+ * frame buffer, and only the rows that changed are sent to the device. Frames
+ * that repeat the frame before them are not sent at all.
+ *
+ * ```
+ * FrameFile file{"loop.frames"};
+ * FramePlayer player{device, file};
+ * player.play(0);
+ * ```
+ */
+class FramePlayer {
+
+private:
+
+  /**
+   * Chain that the frames are played on.
+   */
+  MAX7219Chain& device;
+
+  /**
+   * File that the frames are played from.
+   */
+  const FrameFile& file;
+
+  /**
+   * Decodes the frames of the file.
+   */
+  FrameDecoder decoder;
+
+  /**
+   * Paces playback at the frame period of the file.
+   */
+  FrameScheduler scheduler;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FramePlayer(const FramePlayer&) = delete;
+  FramePlayer(FramePlayer&&) = delete;
+  FramePlayer& operator=(const FramePlayer&) = delete;
+  FramePlayer& operator=(FramePlayer&&) = delete;
+
+  /**
+   * @brief Constructs a player for a frame file.
+   *
+   * @param device chain to play the frames on; must outlive the player
+   * @param file file to play the frames from; must outlive the player
+   * @param policy what to do when a frame misses its deadline
+   */
+  FramePlayer(MAX7219Chain& device, const FrameFile& file,
+              FrameScheduler::MissedDeadlinePolicy policy
+                = FrameScheduler::MissedDeadlinePolicy::SKIP);
+
+  /**
+   * @brief Plays the frames of the file from the first frame to the last.
+   *
+   * Frames whose deadline has already passed are skipped or caught up on as
+   * set by the policy, so the loop keeps to the time it was recorded for.
+   *
+   * @param loop_count number of times to play the frames; `0` plays them
+   *                   until the program is stopped
+   *
+   * @throws std::invalid_argument if the file was recorded for a chain of a
+   *         different length or orientation
+   */
+  void play(std::uint64_t loop_count = 1);
+
+  /**
+   * @brief Returns the timing statistics of the frames played so far.
+   *
+   * @return frame timing statistics
+   */
+  const FrameScheduler::Statistics& get_statistics() const;
+
+};  // class FramePlayer
+
+inline const FrameScheduler::Statistics& FramePlayer::get_statistics() const {
+  return scheduler.get_statistics();
+}
+
+#endif  // SCROLLER_FRAME_PLAYER_H_
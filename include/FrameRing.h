@@ -0,0 +1,492 @@
+/**
+ * @file FrameRing.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_RING_H_
+#define SCROLLER_FRAME_RING_H_
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @brief Fixed-capacity queue of preallocated slots that passes frames from
+ *        one thread to another without locks while neither thread waits.
+ *
+ * Exactly one producer thread fills slots and exactly one consumer thread
+ * empties them. Slots are built once by the constructor and reused in turn,
+ * so frames are written into them in place and passing a frame allocates
+ * nothing. The producer and the consumer each advance their own counter, and
+ * the slots between the two counters hold the frames that are queued.
+ *
+ * A side that finds the ring full or empty can wait for the other side with
+ * `wait_for_write_slot()` or `wait_for_read_slot()`. It spins briefly and
+ * then sleeps, and the other side only takes a lock to wake it when it is
+ * known to be sleeping, so passing frames stays lock-free while neither side
+ * is waiting.
+ *
+ * ```
+ * // producer
+ * FrameStore* slot = ring.get_write_slot();
+ * if (slot != nullptr) {
+ *   slot->clear();
+ *   device.record_frame(view, *slot);
+ *   ring.publish();
+ * }
+ *
+ * // consumer
+ * FrameStore* slot = ring.get_read_slot();
+ * if (slot != nullptr) {
+ *   device.display(*slot, 0);
+ *   ring.release();
+ * }
+ * ```
+ *
+ * @tparam Slot type of the frames held by the ring
+ */
+template <typename Slot>
+class FrameRing {
+
+private:
+
+  /**
+   * Size of a cache line; the counters are kept on separate lines so that
+   * the producer and the consumer do not invalidate each other's cache.
+   */
+  static const std::size_t CACHE_LINE_SIZE{64};
+
+  /**
+   * Number of times a waiting side yields before it goes to sleep; the other
+   * side usually frees or fills a slot within a few yields when it is about
+   * as fast.
+   */
+  static const std::size_t SPIN_COUNT{64};
+
+  /**
+   * Preallocated slots, used in turn.
+   */
+  std::vector<Slot> slots;
+
+  /**
+   * Number of frames published so far; only written by the producer.
+   */
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> write_count;
+
+  /**
+   * Largest number of frames that have been queued at once; only written by
+   * the producer.
+   */
+  std::atomic<std::size_t> peak_depth;
+
+  /**
+   * Whether the producer will publish no more frames.
+   */
+  std::atomic<bool> closed;
+
+  /**
+   * Whether waiting sides should give up and return `nullptr`.
+   */
+  std::atomic<bool> cancelled;
+
+  /**
+   * Number of frames released so far; only written by the consumer.
+   */
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> read_count;
+
+  /**
+   * Whether the producer is sleeping until a slot is released.
+   */
+  alignas(CACHE_LINE_SIZE) std::atomic<bool> producer_waiting;
+
+  /**
+   * Whether the consumer is sleeping until a frame is published.
+   */
+  std::atomic<bool> consumer_waiting;
+
+  /**
+   * Guards going to sleep on `slot_changed` and waking a sleeping side.
+   */
+  std::mutex wait_mutex;
+
+  /**
+   * Signals a sleeping side that a slot was released or a frame published,
+   * or that the ring was closed or cancelled.
+   */
+  std::condition_variable slot_changed;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameRing(const FrameRing&) = delete;
+  FrameRing(FrameRing&&) = delete;
+  FrameRing& operator=(const FrameRing&) = delete;
+  FrameRing& operator=(FrameRing&&) = delete;
+
+  /**
+   * @brief Constructs an empty ring and builds each of its slots.
+   *
+   * @tparam MakeSlot callable that takes no arguments and returns a `Slot`
+   * @param capacity number of slots, which is the most frames that can be
+   *                 queued at once
+   * @param make_slot builds each slot, e.g. with room for a whole frame
+   *
+   * @throws std::invalid_argument if the capacity is 0
+   */
+  template <typename MakeSlot>
+  FrameRing(std::size_t capacity, MakeSlot make_slot);
+
+  /**
+   * @brief Returns the slot for the next frame if one is free; called only
+   *        by the producer.
+   *
+   * @return free slot to write the next frame into, or `nullptr` if the ring
+   *         is full
+   */
+  Slot* get_write_slot();
+
+  /**
+   * @brief Waits until a slot is free and returns it; called only by the
+   *        producer.
+   *
+   * @return free slot to write the next frame into, or `nullptr` if the
+   *         ring was cancelled
+   */
+  Slot* wait_for_write_slot();
+
+  /**
+   * @brief Queues the frame written into the slot returned by
+   *        `get_write_slot()`; called only by the producer.
+   */
+  void publish();
+
+  /**
+   * @brief Marks that no more frames will be published; called only by the
+   *        producer.
+   */
+  void close();
+
+  /**
+   * @brief Returns the slot holding the oldest queued frame; called only by
+   *        the consumer.
+   *
+   * @return slot holding the next frame, or `nullptr` if the ring is empty
+   */
+  Slot* get_read_slot();
+
+  /**
+   * @brief Waits until a frame is queued and returns its slot; called only
+   *        by the consumer.
+   *
+   * Cancellation is checked first, so no more frames are returned once the
+   * ring is cancelled, even if some are still queued.
+   *
+   * @return slot holding the next frame, or `nullptr` if the ring was
+   *         cancelled or is drained
+   */
+  Slot* wait_for_read_slot();
+
+  /**
+   * @brief Frees the slot returned by `get_read_slot()` for the producer to
+   *        reuse; called only by the consumer.
+   */
+  void release();
+
+  /**
+   * @brief Returns whether the producer has closed the ring and every frame
+   *        that it published has been released; called only by the
+   *        consumer.
+   *
+   * @return `true` if no more frames will become available
+   */
+  bool is_drained() const;
+
+  /**
+   * @brief Makes both sides stop waiting and return `nullptr` from then on;
+   *        may be called from any thread.
+   */
+  void cancel();
+
+  /**
+   * @brief Empties the ring and opens it again, clearing any cancellation;
+   *        called only while neither the producer nor the consumer is using
+   *        it.
+   */
+  void reset();
+
+  /**
+   * @brief Returns the number of slots.
+   *
+   * @return capacity of the ring
+   */
+  std::size_t get_capacity() const;
+
+  /**
+   * @brief Returns the number of frames queued; may be called from any
+   *        thread, and is exact only when neither side is active.
+   *
+   * @return queue depth
+   */
+  std::size_t get_depth() const;
+
+  /**
+   * @brief Returns the largest number of frames that have been queued at
+   *        once; may be called from any thread.
+   *
+   * A peak depth that stays at the capacity means that the consumer is the
+   * slower side, and one that stays near 0 means that the producer is.
+   *
+   * @return peak queue depth
+   */
+  std::size_t get_peak_depth() const;
+
+private:
+
+  /**
+   * @brief Wakes the other side if it is sleeping; called after a frame is
+   *        published or a slot released.
+   *
+   * @param waiting flag of the side to wake
+   */
+  void wake(const std::atomic<bool>& waiting);
+
+  /**
+   * @brief Sleeps until a condition holds or the ring is cancelled.
+   *
+   * @param waiting flag of the sleeping side
+   * @param ready condition that ends the wait
+   */
+  template <typename Ready>
+  void sleep_until(std::atomic<bool>& waiting, Ready ready);
+
+};  // class FrameRing
+
+template <typename Slot>
+template <typename MakeSlot>
+FrameRing<Slot>::FrameRing(std::size_t capacity, MakeSlot make_slot)
+  : slots{}
+  , write_count{0}
+  , peak_depth{0}
+  , closed{false}
+  , cancelled{false}
+  , read_count{0}
+  , producer_waiting{false}
+  , consumer_waiting{false}
+  , wait_mutex{}
+  , slot_changed{} {
+
+  // throw an exception if the capacity provided is invalid
+  if (capacity == 0) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "ring capacity must be greater than 0"
+    };
+  }
+
+  slots.reserve(capacity);
+  for (std::size_t i = 0; i < capacity; i++) {
+    slots.push_back(make_slot());
+  }
+}
+
+template <typename Slot>
+Slot* FrameRing<Slot>::get_write_slot() {
+
+  // the acquire pairs with the release in release(), so the consumer is done
+  // with a slot before the producer writes into it again
+  std::uint64_t written{write_count.load(std::memory_order_relaxed)};
+  if (written - read_count.load(std::memory_order_acquire) == slots.size()) {
+    return nullptr;
+  }
+
+  return &slots[written % slots.size()];
+}
+
+template <typename Slot>
+Slot* FrameRing<Slot>::wait_for_write_slot() {
+
+  for (std::size_t attempt = 0; ; attempt++) {
+
+    if (cancelled.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    if (Slot* slot = get_write_slot()) {
+      return slot;
+    }
+
+    // the consumer usually frees a slot soon after taking a frame, but a
+    // consumer that is much slower, such as one sending frames over SPI,
+    // would keep a spinning producer using a whole core
+    if (attempt < SPIN_COUNT) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    sleep_until(producer_waiting, [this] {
+      return write_count.load(std::memory_order_relaxed)
+             - read_count.load(std::memory_order_acquire) != slots.size();
+    });
+  }
+}
+
+template <typename Slot>
+void FrameRing<Slot>::publish() {
+
+  std::uint64_t written{write_count.load(std::memory_order_relaxed) + 1};
+  write_count.store(written, std::memory_order_release);
+
+  std::size_t depth{static_cast<std::size_t>(
+    written - read_count.load(std::memory_order_relaxed))};
+  if (depth > peak_depth.load(std::memory_order_relaxed)) {
+    peak_depth.store(depth, std::memory_order_relaxed);
+  }
+
+  wake(consumer_waiting);
+}
+
+template <typename Slot>
+void FrameRing<Slot>::close() {
+  closed.store(true, std::memory_order_release);
+  wake(consumer_waiting);
+}
+
+template <typename Slot>
+Slot* FrameRing<Slot>::get_read_slot() {
+
+  // the acquire pairs with the release in publish(), so the frame written
+  // into a slot is visible before the slot is read
+  std::uint64_t read{read_count.load(std::memory_order_relaxed)};
+  if (write_count.load(std::memory_order_acquire) == read) {
+    return nullptr;
+  }
+
+  return &slots[read % slots.size()];
+}
+
+template <typename Slot>
+Slot* FrameRing<Slot>::wait_for_read_slot() {
+
+  for (std::size_t attempt = 0; ; attempt++) {
+
+    // cancellation comes first so that queued frames are abandoned
+    if (cancelled.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    if (Slot* slot = get_read_slot()) {
+      return slot;
+    }
+    if (is_drained()) {
+      return nullptr;
+    }
+
+    if (attempt < SPIN_COUNT) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    sleep_until(consumer_waiting, [this] {
+      return write_count.load(std::memory_order_acquire)
+             != read_count.load(std::memory_order_relaxed)
+             || closed.load(std::memory_order_acquire);
+    });
+  }
+}
+
+template <typename Slot>
+void FrameRing<Slot>::release() {
+  read_count.store(read_count.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+  wake(producer_waiting);
+}
+
+template <typename Slot>
+bool FrameRing<Slot>::is_drained() const {
+
+  // the ring is checked for frames after it is found to be closed, since
+  // frames published before it was closed may not have been seen yet
+  return closed.load(std::memory_order_acquire)
+         && write_count.load(std::memory_order_acquire)
+            == read_count.load(std::memory_order_relaxed);
+}
+
+template <typename Slot>
+void FrameRing<Slot>::cancel() {
+
+  cancelled.store(true, std::memory_order_release);
+
+  // cancelling is rare, so both sides are woken without checking whether
+  // either of them is sleeping
+  std::lock_guard<std::mutex> lock{wait_mutex};
+  slot_changed.notify_all();
+}
+
+template <typename Slot>
+void FrameRing<Slot>::reset() {
+  write_count.store(0, std::memory_order_relaxed);
+  read_count.store(0, std::memory_order_relaxed);
+  peak_depth.store(0, std::memory_order_relaxed);
+  closed.store(false, std::memory_order_relaxed);
+  cancelled.store(false, std::memory_order_relaxed);
+}
+
+template <typename Slot>
+std::size_t FrameRing<Slot>::get_capacity() const {
+  return slots.size();
+}
+
+template <typename Slot>
+std::size_t FrameRing<Slot>::get_depth() const {
+
+  // the read count is loaded first so that the depth is never negative
+  std::uint64_t read{read_count.load(std::memory_order_acquire)};
+  return static_cast<std::size_t>(
+    write_count.load(std::memory_order_acquire) - read);
+}
+
+template <typename Slot>
+std::size_t FrameRing<Slot>::get_peak_depth() const {
+  return peak_depth.load(std::memory_order_relaxed);
+}
+
+template <typename Slot>
+void FrameRing<Slot>::wake(const std::atomic<bool>& waiting) {
+
+  // the fence pairs with the one in sleep_until(): either this side sees
+  // that the other is going to sleep, or the other side sees the counter
+  // that was just updated and does not go to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!waiting.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // the sleeping side checks its condition while holding the lock, so
+  // taking it here means the notification cannot arrive before it sleeps
+  std::lock_guard<std::mutex> lock{wait_mutex};
+  slot_changed.notify_all();
+}
+
+template <typename Slot>
+template <typename Ready>
+void FrameRing<Slot>::sleep_until(std::atomic<bool>& waiting, Ready ready) {
+
+  std::unique_lock<std::mutex> lock{wait_mutex};
+  waiting.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  slot_changed.wait(lock, [this, &ready] {
+    return ready() || cancelled.load(std::memory_order_acquire);
+  });
+
+  waiting.store(false, std::memory_order_relaxed);
+}
+
+#endif  // SCROLLER_FRAME_RING_H_
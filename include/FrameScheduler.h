@@ -0,0 +1,246 @@
+/**
+ * @file FrameScheduler.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef FRAME_SCHEDULER_H_
+#define FRAME_SCHEDULER_H_
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Paces frames on an absolute, monotonic timeline at a fixed rate.
+ *
+ * Frame `n` is due at `start + n * frame_period`, where `start` is the time
+ * of the first call to `wait_for_next_frame()`. Since deadlines are absolute
+ * rather than relative to the end of the previous frame, the time taken to
+ * render and send a frame does not add to the frame period and the schedule
+ * does not drift.
+ *
+ * ```
+ * MAX7219Chain device{8, 0, false, 0};
+ * FrameScheduler scheduler{30.0};
+ * while (true) {
+ *   std::uint64_t frame = scheduler.wait_for_next_frame();
+ *   // draw frame number `frame` and display it
+ * }
+ * ```
+ */
+class FrameScheduler {
+
+public:
+
+  /**
+   * What to do when a frame is requested after its deadline has passed.
+   */
+  enum class MissedDeadlinePolicy {
+
+    /**
+     * Jump ahead to the most recent frame that is due and drop the frames in
+     * between, so that animation position always follows wall-clock time.
+     */
+    SKIP,
+
+    /**
+     * Return every late frame immediately, one after another, until the
+     * schedule is caught up, so that no frame is dropped.
+     */
+    CATCH_UP,
+
+  };
+
+  /**
+   * Timing statistics for the frames returned by `wait_for_next_frame()`.
+   * Jitter is the difference between the time a frame was returned and its
+   * deadline.
+   */
+  struct Statistics {
+
+    /**
+     * Number of frames returned.
+     */
+    std::uint64_t frame_count;
+
+    /**
+     * Number of frames that were requested a full frame period or more after
+     * their deadline, i.e. once the following frame was also due.
+     */
+    std::uint64_t missed_deadline_count;
+
+    /**
+     * Number of frames dropped by the `SKIP` policy.
+     */
+    std::uint64_t skipped_frame_count;
+
+    /**
+     * Jitter of the most recent frame.
+     */
+    std::chrono::nanoseconds last_jitter;
+
+    /**
+     * Smallest jitter of any frame.
+     */
+    std::chrono::nanoseconds min_jitter;
+
+    /**
+     * Largest jitter of any frame.
+     */
+    std::chrono::nanoseconds max_jitter;
+
+    /**
+     * Sum of the jitter of all frames; divide by `frame_count` for the mean.
+     */
+    std::chrono::nanoseconds total_jitter;
+
+  };
+
+private:
+
+  /**
+   * Time between consecutive frame deadlines.
+   */
+  const std::chrono::nanoseconds frame_period;
+
+  /**
+   * Policy applied when a frame is requested after its deadline.
+   */
+  const MissedDeadlinePolicy policy;
+
+  /**
+   * Whether the timeline has been started.
+   */
+  bool started;
+
+  /**
+   * Time, on the monotonic clock, at which frame `0` was due.
+   */
+  std::chrono::nanoseconds start_time;
+
+  /**
+   * Index of the next frame to be returned.
+   */
+  std::uint64_t next_frame;
+
+  /**
+   * Statistics for the frames returned so far.
+   */
+  Statistics statistics;
+
+public:
+
+  /**
+   * @brief Constructs a scheduler that runs at the specified frame rate.
+   * 
+   * @param frames_per_second number of frames per second
+   * @param policy policy to apply when a deadline is missed
+   * 
+   * @throws std::invalid_argument if the frame rate is not a finite number
+   *         greater than 0, or is so high that the frame period would be 0
+   */
+  FrameScheduler(double frames_per_second,
+                 MissedDeadlinePolicy policy = MissedDeadlinePolicy::SKIP);
+
+  /**
+   * @brief Constructs a scheduler with the specified frame period.
+   * 
+   * @param frame_period time between consecutive frames
+   * @param policy policy to apply when a deadline is missed
+   * 
+   * @throws std::invalid_argument if the frame period is not greater than 0
+   */
+  FrameScheduler(std::chrono::nanoseconds frame_period,
+                 MissedDeadlinePolicy policy = MissedDeadlinePolicy::SKIP);
+
+  /**
+   * @brief Sleeps until the next frame is due and returns its index.
+   * 
+   * The first call starts the timeline and returns frame `0` immediately.
+   * With the `SKIP` policy, indices of dropped frames are never returned,
+   * so the returned index should be used to position animations.
+   * 
+   * @return index of the frame that is now due
+   */
+  std::uint64_t wait_for_next_frame();
+
+  /**
+   * @brief Restarts the timeline; the next call to `wait_for_next_frame()`
+   *        returns frame `0` immediately.
+   */
+  void restart();
+
+  /**
+   * @brief Returns the time between consecutive frames.
+   * 
+   * @return frame period
+   */
+  std::chrono::nanoseconds get_frame_period() const;
+
+  /**
+   * @brief Returns the timing statistics of the frames returned so far.
+   * 
+   * @return frame timing statistics
+   */
+  const Statistics& get_statistics() const;
+
+  /**
+   * @brief Sets all frame timing statistics back to zero.
+   */
+  void reset_statistics();
+
+private:
+
+  /**
+   * @brief Converts a frame rate into a frame period.
+   * 
+   * @param frames_per_second number of frames per second
+   * @return time between consecutive frames
+   * 
+   * @throws std::invalid_argument if the frame rate is not a finite number
+   *         greater than 0 or its period does not fit in nanoseconds
+   */
+  static std::chrono::nanoseconds to_frame_period(double frames_per_second);
+
+  /**
+   * @brief Returns the current time of the monotonic clock.
+   * 
+   * @return current monotonic time
+   */
+  static std::chrono::nanoseconds now();
+
+  /**
+   * @brief Sleeps until the specified time of the monotonic clock.
+   * 
+   * @param deadline monotonic time until which to sleep
+   */
+  static void sleep_until(std::chrono::nanoseconds deadline);
+
+  /**
+   * @brief Adds a returned frame to the statistics.
+   * 
+   * @param jitter difference between the return time and the deadline
+   */
+  void record_frame(std::chrono::nanoseconds jitter);
+
+};  // class FrameScheduler
+
+inline std::chrono::nanoseconds FrameScheduler::get_frame_period() const {
+  return frame_period;
+}
+
+inline const FrameScheduler::Statistics&
+    FrameScheduler::get_statistics() const {
+  return statistics;
+}
+
+inline void FrameScheduler::reset_statistics() {
+  statistics = Statistics{};
+}
+
+inline void FrameScheduler::restart() {
+  started = false;
+  next_frame = 0;
+}
+
+#endif  // FRAME_SCHEDULER_H_
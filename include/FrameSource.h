@@ -0,0 +1,98 @@
+/**
+ * @file FrameSource.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_SOURCE_H_
+#define SCROLLER_FRAME_SOURCE_H_
+
+#include <cstddef>
+
+#include "ChainImageView.h"
+
+/**
+ * @brief Abstract sequence of frames that are produced on demand, one at a
+ *        time, for display on a `MAX7219Chain`.
+ *
+ * A frame source does not hold every frame of an animation in memory; it
+ * produces the frame at its current position when `get_frame()` is called,
+ * reusing the same buffer for every frame. Frames are addressed by index so
+ * that a `FrameScheduler` can skip frames when it falls behind.
+ *
+ * ```
+ * for (source.set_frame(scheduler.wait_for_next_frame());
+ *      !source.is_finished();
+ *      source.set_frame(scheduler.wait_for_next_frame())) {
+ *
+ *   device.display(source.get_frame());
+ * }
+ * ```
+ */
+class FrameSource {
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameSource(const FrameSource&) = delete;
+  FrameSource(FrameSource&&) = delete;
+  FrameSource& operator=(const FrameSource&) = delete;
+  FrameSource& operator=(FrameSource&&) = delete;
+
+  /**
+   * @brief Constructs a frame source.
+   */
+  FrameSource();
+
+  virtual ~FrameSource();
+
+  /**
+   * @brief Moves the source to the specified frame.
+   *
+   * @param frame index of the frame to produce next
+   */
+  virtual void set_frame(std::size_t frame) = 0;
+
+  /**
+   * @brief Returns the index of the frame that the source is at.
+   *
+   * @return current frame index
+   */
+  virtual std::size_t get_frame_index() const = 0;
+
+  /**
+   * @brief Returns whether the source has moved past its last frame.
+   *
+   * @return `true` if there are no more frames to produce
+   */
+  virtual bool is_finished() const = 0;
+
+  /**
+   * @brief Produces the frame at the current position.
+   *
+   * @return view of the frame, valid until the source is moved, produces
+   *         another frame, or is destroyed
+   */
+  virtual ChainImageView get_frame() = 0;
+
+  /**
+   * @brief Moves the source forward by one or more frames.
+   *
+   * @param count number of frames to move forward by
+   */
+  void next_frame(std::size_t count = 1);
+
+};  // class FrameSource
+
+inline FrameSource::FrameSource() { /* no body */ }
+
+inline FrameSource::~FrameSource() {}
+
+inline void FrameSource::next_frame(std::size_t count) {
+  set_frame(get_frame_index() + count);
+}
+
+#endif  // SCROLLER_FRAME_SOURCE_H_
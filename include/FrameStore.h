@@ -0,0 +1,241 @@
+/**
+ * @file FrameStore.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_FRAME_STORE_H_
+#define SCROLLER_FRAME_STORE_H_
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#include "MatrixImage.h"
+
+/**
+ * @brief Pre-rendered frames for a chain of a specific length, stored back
+ *        to back in a single contiguous arena.
+ *
+ * Each frame holds only the row data latched into the chain, `8 * length`
+ * bytes stored row-major (index `row * length + matrix`), already oriented
+ * for the device. The row register bytes that accompany the data on the bus
+ * are implied by the position of each byte and are added by the chain when a
+ * frame is sent, so a frame takes half of the space of its commands and no
+ * allocation of its own. The store also keeps the module transform table of
+ * the chain that recorded it (see `MAX7219Chain::get_transform_table_id()`),
+ * so that its frames are not displayed on a chain wired differently.
+ *
+ * ```
+ * FrameStore store{device_length};
+ * for (source.set_frame(0); !source.is_finished(); source.next_frame()) {
+ *   device.record_frame(source.get_frame(), store);
+ * }
+ * for (std::size_t frame = 0; frame < store.get_frame_count(); frame++) {
+ *   device.display(store, frame);
+ * }
+ * ```
+ */
+class FrameStore {
+
+private:
+
+  /**
+   * Number of 8x8 matrices in the chain that the frames are rendered for.
+   */
+  const std::size_t length;
+
+  /**
+   * Number of bytes in each frame.
+   */
+  const std::size_t frame_size;
+
+  /**
+   * Module transform table of the chain that the frames are rendered for.
+   */
+  std::uint64_t transform_table_id;
+
+  /**
+   * Row data of every frame, one frame after another.
+   */
+  std::vector<std::uint8_t> arena;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  FrameStore(const FrameStore&) = delete;
+  FrameStore& operator=(const FrameStore&) = delete;
+  FrameStore& operator=(FrameStore&&) = delete;
+
+  /**
+   * @brief Constructs a store that takes over the frames of another store.
+   */
+  FrameStore(FrameStore&& store_to_move) noexcept = default;
+
+  /**
+   * @brief Constructs an empty store for a chain of the specified length.
+   *
+   * @param length number of 8x8 matrices in the chain
+   * @param frame_capacity number of frames to reserve space for, so that
+   *                       recording that many frames does not reallocate
+   *                       the arena
+   */
+  FrameStore(std::size_t length, std::size_t frame_capacity = 0);
+
+  /**
+   * @brief Returns the number of matrices in the chain that the frames are
+   *        rendered for.
+   *
+   * @return chain length in matrices
+   */
+  std::size_t get_length() const;
+
+  /**
+   * @brief Returns the number of bytes in each frame.
+   *
+   * @return size of a frame in bytes
+   */
+  std::size_t get_frame_size() const;
+
+  /**
+   * @brief Returns the module transform table of the chain that the frames
+   *        are rendered for.
+   *
+   * @return transform table identifier; `0` for a chain with a single
+   *         orientation
+   */
+  std::uint64_t get_transform_table_id() const;
+
+  /**
+   * @brief Sets the module transform table of the chain that the frames are
+   *        rendered for; called by the chain when it records into an empty
+   *        store.
+   *
+   * @param transform_table_id transform table identifier of the chain
+   */
+  void set_transform_table_id(std::uint64_t transform_table_id);
+
+  /**
+   * @brief Returns the number of frames in the store.
+   *
+   * @return frame count
+   */
+  std::size_t get_frame_count() const;
+
+  /**
+   * @brief Returns the number of bytes of row data held by the store.
+   *
+   * @return size of all of the frames in bytes
+   */
+  std::size_t get_byte_size() const;
+
+  /**
+   * @brief Reserves space for a number of frames in the arena.
+   *
+   * @param frame_capacity total number of frames to reserve space for
+   */
+  void reserve(std::size_t frame_capacity);
+
+  /**
+   * @brief Adds a blank frame to the end of the store.
+   *
+   * @return row data of the new frame, to be filled in by the caller; valid
+   *         until the next frame is added
+   */
+  std::uint8_t* append_frame();
+
+  /**
+   * @brief Adds a copy of a frame to the end of the store.
+   *
+   * @param rows row data of the frame, `get_frame_size()` bytes long
+   */
+  void append_frame(const std::uint8_t* rows);
+
+  /**
+   * @brief Returns the row data of a frame.
+   *
+   * @param frame index of the frame
+   * @return row data of the frame; valid until the next frame is added
+   *
+   * @throws std::out_of_range if there is no frame with the specified index
+   */
+  const std::uint8_t* get_frame(std::size_t frame) const;
+
+  /**
+   * @brief Removes every frame from the store, keeping the arena's capacity.
+   */
+  void clear();
+
+};  // class FrameStore
+
+inline FrameStore::FrameStore(std::size_t length, std::size_t frame_capacity)
+  : length{length}
+  , frame_size{MatrixImage::HEIGHT * length}
+  , transform_table_id{0}
+  , arena{} {
+
+  reserve(frame_capacity);
+}
+
+inline std::size_t FrameStore::get_length() const {
+  return length;
+}
+
+inline std::size_t FrameStore::get_frame_size() const {
+  return frame_size;
+}
+
+inline std::uint64_t FrameStore::get_transform_table_id() const {
+  return transform_table_id;
+}
+
+inline void FrameStore::set_transform_table_id(
+    std::uint64_t transform_table_id) {
+  this->transform_table_id = transform_table_id;
+}
+
+inline std::size_t FrameStore::get_frame_count() const {
+  return frame_size != 0 ? arena.size() / frame_size : 0;
+}
+
+inline std::size_t FrameStore::get_byte_size() const {
+  return arena.size();
+}
+
+inline void FrameStore::reserve(std::size_t frame_capacity) {
+  arena.reserve(frame_capacity * frame_size);
+}
+
+inline std::uint8_t* FrameStore::append_frame() {
+  arena.resize(arena.size() + frame_size);
+  return arena.data() + arena.size() - frame_size;
+}
+
+inline void FrameStore::append_frame(const std::uint8_t* rows) {
+  arena.insert(arena.end(), rows, rows + frame_size);
+}
+
+inline const std::uint8_t* FrameStore::get_frame(std::size_t frame) const {
+
+  // throw an exception if the frame index provided is invalid
+  if (frame >= get_frame_count()) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame index must be less than frame count of "
+      + std::to_string(get_frame_count()) + "; provided value was "
+      + std::to_string(frame)
+    };
+  }
+
+  return arena.data() + frame * frame_size;
+}
+
+inline void FrameStore::clear() {
+  arena.clear();
+}
+
+#endif  // SCROLLER_FRAME_STORE_H_
@@ -46,86 +46,197 @@ public:
    */
   static const std::size_t WIDTH_MAX{8};
 
+  /**
+   * Flag marking a glyph whose advance does not include the spacing of its
+   * font, such as a separator that must stay one column wide.
+   */
+  static const std::uint8_t FIXED_ADVANCE{0x01};
+
 private:
 
   /**
    * `Glyph` data is stored as an array of 8-bit unsigned integers where
-   * each pixel is represented by a single bit.
+   * each pixel is represented by a single bit; the data is kept as it
+   * appears in the font so that it can be drawn with or without trimming.
+   */
+  std::array<std::uint8_t, HEIGHT> glyph_data;
+
+  /**
+   * Number of blank columns to the left of the glyph, which are removed when
+   * the glyph is drawn proportionally.
+   */
+  std::uint8_t left_bearing;
+
+  /**
+   * Width of the glyph when drawn proportionally, before spacing is added;
+   * since the 8-bit integers used to represent rows of a glyph must be `8`
+   * wide, the width that we want to use when printing them must be stored
+   * separately.
    */
-  std::array<std::uint_fast8_t, HEIGHT> glyph_data;
+  std::uint8_t advance;
 
   /**
-   * Width of the `Glyph` when drawn including any spacing; since the 8-bit
-   * integers used to represent rows of a glyph must be `8` wide, the width
-   * that we want to use when printing them must be stored separately.
+   * Flags describing how the glyph is drawn, such as `FIXED_ADVANCE`.
    */
-  std::size_t glyph_width;
+  std::uint8_t flags;
 
 public:
 
   /**
-   * Deletion of functions that could potentially be implicitly declared in
-   * order to prevent errors from accidental use.
+   * @brief Constructs a blank glyph with an advance of `0`.
    */
-  Glyph(const Glyph&) = delete;
-  Glyph(Glyph&&) = delete;
-  Glyph& operator=(const Glyph&) = delete;
-  Glyph& operator=(Glyph&&) = delete;
+  Glyph();
 
   /**
-   * @brief Construct a `Glyph` by supplying data, codepoint,
-   *        proportionality, and and spacing information.
+   * @brief Construct a `Glyph` from data alone, computing its metrics from
+   *        the columns in which any pixel is set to on.
    * 
-   * A `Glyph` in its default form would have `proportional` set to `false`
-   * and spacing of zero which would make each Glyph have an 8x8 size.
-   * Setting proportional to `true` trims all excess width from a character
-   * so that its width is equal to the number of columns between the left-
-   * most and right-most columns with any pixel set to on. After this
-   * adjustment, spacing adds a specified number of empty columns.
-   * 
-   * ASCII codepoints 0x20 and 0xFF are special when proportional is used in
-   * that 0x20 and 0xFF both have no pixels set to on but have widths of `4`
-   * and `1` repsectively prior to addition of spacing. In addition,
-   * codepoint 0x20 is affected by spacing whereas 0xFF is not.
+   * The left bearing is the number of blank columns to the left of the
+   * left-most column with any pixel set to on, and the advance is the number
+   * of columns from there to the right-most column with any pixel set to on.
+   * A glyph with no pixels set to on has a left bearing and advance of `0`.
    * 
    * @param data information describing how to draw the glyph
-   * @param proportional whether to draw the glyph with excess whitespace
-   *                     removed from both sides of the glyph
-   * @param code_point integer position of the glyph in UTF-8
-   * @param spacing number of blank columns of spacing to include at the end
-   *                of the glyph
+   */
+  explicit Glyph(const std::array<std::uint8_t, HEIGHT>& data);
+
+  /**
+   * @brief Construct a `Glyph` from data and metrics that were computed in
+   *        advance, such as those stored in a font container.
    * 
-   * @warning Maximum glyph width of 8 cannot be exceeded; glyphs for which
-   *          spacing increases width beyond 8, will be truncated at width 8.
+   * @param data information describing how to draw the glyph
+   * @param left_bearing number of blank columns to the left of the glyph
+   * @param advance width of the glyph with excess whitespace removed
+   * @param flags flags describing how the glyph is drawn
    */
-  Glyph(std::array<uint8_t, HEIGHT>& data, bool proportional,
-        std::uint_fast8_t code_point, std::size_t spacing);
+  Glyph(const std::array<std::uint8_t, HEIGHT>& data,
+        std::uint_fast8_t left_bearing, std::uint_fast8_t advance,
+        std::uint_fast8_t flags);
 
   /**
-   * @brief Returns the value of the pixel at the specified position.
+   * @brief Returns the value of the pixel at the specified position of the
+   *        glyph as it is stored in the font.
    * 
    * @param row row of the pixel to be retrieved
    * @param col column of the pixel to be retrieved
    * @return `1` if the specified pixel is set on or `0` if the pixel is set
    *         off
    */
-  std::uint_fast8_t get_pixel(std::size_t row, std::size_t col);
+  std::uint_fast8_t get_pixel(std::size_t row, std::size_t col) const;
+
+  /**
+   * @brief Returns the data for an entire row of this glyph as it is stored
+   *        in the font.
+   * 
+   * @param row row for which to return glyph data
+   * @return glyph data for a row where the most-significant bit represents
+   *         column `0`
+   */
+  std::uint_fast8_t get_row(std::size_t row) const;
+
+  /**
+   * @brief Returns the data for an entire row of this glyph as it is drawn.
+   * 
+   * @param row row for which to return glyph data
+   * @param proportional whether the glyph is drawn with excess whitespace
+   *                     removed, in which case the row is shifted left by the
+   *                     left bearing
+   * @return glyph data for a row where the most-significant bit represents
+   *         the first column drawn
+   */
+  std::uint_fast8_t get_drawn_row(std::size_t row, bool proportional) const;
+
+  /**
+   * @brief Returns the number of blank columns to the left of this glyph.
+   * 
+   * @return left bearing of this glyph in pixels
+   */
+  std::size_t get_left_bearing() const;
+
+  /**
+   * @brief Returns the width of this glyph with excess whitespace removed.
+   * 
+   * @return advance of this glyph in pixels
+   */
+  std::size_t get_advance() const;
+
+  /**
+   * @brief Returns the flags describing how this glyph is drawn.
+   * 
+   * @return flags of this glyph
+   */
+  std::uint_fast8_t get_flags() const;
 
   /**
-   * @brief Returns the width of this glyph in pixels.
+   * @brief Returns the width of this glyph in pixels as it is drawn.
+   * 
+   * A glyph that is not drawn proportionally is always `8` wide. A glyph
+   * that is drawn proportionally is as wide as its advance plus the spacing,
+   * unless it has the `FIXED_ADVANCE` flag, in which case the spacing is not
+   * added.
    * 
+   * @param proportional whether the glyph is drawn with excess whitespace
+   *                     removed
+   * @param spacing number of blank columns of spacing to include at the end
+   *                of the glyph
    * @return pixel width of this glyph
+   * 
+   * @warning Maximum glyph width of 8 cannot be exceeded; glyphs for which
+   *          spacing increases width beyond 8, will be truncated at width 8.
    */
-  std::size_t get_width();
+  std::size_t get_width(bool proportional, std::size_t spacing) const;
 
 };
 
-inline std::uint_fast8_t Glyph::get_pixel(std::size_t row, std::size_t col) {
+inline Glyph::Glyph()
+  : glyph_data{}
+  , left_bearing{0}
+  , advance{0}
+  , flags{0} { /* no body */ }
+
+inline Glyph::Glyph(const std::array<std::uint8_t, HEIGHT>& data,
+                    std::uint_fast8_t left_bearing,
+                    std::uint_fast8_t advance, std::uint_fast8_t flags)
+  : glyph_data(data)
+  , left_bearing{static_cast<std::uint8_t>(left_bearing)}
+  , advance{static_cast<std::uint8_t>(advance)}
+  , flags{static_cast<std::uint8_t>(flags)} { /* no body */ }
+
+inline std::uint_fast8_t Glyph::get_pixel(std::size_t row,
+                                          std::size_t col) const {
   return !!(glyph_data.at(row) & (1 << (WIDTH_MAX - 1 - col)));
 }
 
-inline std::size_t Glyph::get_width() {
-  return glyph_width;
+inline std::uint_fast8_t Glyph::get_row(std::size_t row) const {
+  return glyph_data.at(row) & 0xFF;
+}
+
+inline std::uint_fast8_t Glyph::get_drawn_row(std::size_t row,
+                                              bool proportional) const {
+  return (get_row(row) << (proportional ? left_bearing : 0)) & 0xFF;
+}
+
+inline std::size_t Glyph::get_left_bearing() const {
+  return left_bearing;
+}
+
+inline std::size_t Glyph::get_advance() const {
+  return advance;
+}
+
+inline std::uint_fast8_t Glyph::get_flags() const {
+  return flags;
+}
+
+inline std::size_t Glyph::get_width(bool proportional,
+                                    std::size_t spacing) const {
+
+  if (!proportional) {
+    return WIDTH_MAX;
+  }
+
+  std::size_t width{advance + ((flags & FIXED_ADVANCE) ? 0 : spacing)};
+  return width < WIDTH_MAX ? width : WIDTH_MAX;
 }
 
 #endif  // SCROLLER_GLYPH_H_
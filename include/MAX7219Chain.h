@@ -8,14 +8,104 @@
 #define MAX7219_CHAIN_H_
 
 #include <vector>
-#include "SPI.h"
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "SPITransport.h"
 #include "MAX7219.h"
 #include "MatrixChainImage.h"
+#include "ChainImageView.h"
+#include "FrameStore.h"
+#include "FrameDecoder.h"
 
 class MAX7219Chain : public MAX7219 {
 
+public:
+
+  /**
+   * How the 8x8 section of an image at one matrix index is transformed and
+   * where in the chain it is displayed; used for chains that are made up of
+   * modules that are wired or mounted differently from one another.
+   */
+  struct ModuleTransform {
+
+    /**
+     * Number of 90 degree clockwise rotations to make to the section, after
+     * any mirroring.
+     */
+    std::size_t rotation;
+
+    /**
+     * Whether the section is mirrored left to right.
+     */
+    bool mirror_horizontal;
+
+    /**
+     * Whether the section is mirrored top to bottom.
+     */
+    bool mirror_vertical;
+
+    /**
+     * Index of the matrix in the chain on which the section is displayed,
+     * counted like the matrices of an image passed to `display_raw()`.
+     */
+    std::size_t position;
+
+  };
+
 private:
 
+  /**
+   * Precomputed transform of the 8x8 section of an image at one matrix
+   * index.
+   */
+  struct ModulePlan {
+
+    /**
+     * Index of the matrix in the chain on which the section is displayed.
+     */
+    std::size_t position;
+
+    /**
+     * Rotation and mirroring of the section combined into a single kernel.
+     */
+    MatrixImage::WordTransform transform;
+
+  };
+
+  /**
+   * A precomputed list of commands that is sent to the device as a single
+   * batch of transactions.
+   */
+  struct CommandSequence {
+
+    /**
+     * Command strings for all of the transactions, one after another.
+     */
+    std::vector<char> commands;
+
+    /**
+     * One transaction for each command string in `commands`.
+     */
+    std::vector<SPITransport::Transaction> transactions;
+
+  };
+
+  /**
+   * Transport created by this chain when one is not supplied by the caller;
+   * `nullptr` when the transport is owned by the caller.
+   */
+  std::unique_ptr<SPITransport> owned_transport;
+
+  /**
+   * SPI bus used to send commands to the device.
+   */
+  SPITransport& transport;
+
   /**
    * The number of individual 8x8 LED matrices in the device.
    */
@@ -32,11 +122,150 @@ private:
    */
   const bool upside_down;
 
+  /**
+   * Transform of the section of an image at each matrix index, compiled from
+   * the orientation of the chain or from a table of module transforms.
+   */
+  const std::vector<ModulePlan> transform_plan;
+
+  /**
+   * Identifier of the module transform table that the chain was built from,
+   * a hash of `transform_plan`; `0` for a chain with a single orientation.
+   * Frames are recorded with it so that they are only played on chains that
+   * lay out their modules the same way.
+   */
+  const std::uint64_t transform_table_id;
+
+  /**
+   * Method that writes the row data of a view of an image, as it is to be
+   * latched into the chain, into a row buffer (stored like `latched_rows`).
+   */
+  using RenderKernel = void (MAX7219Chain::*)(const ChainImageView& view,
+                                              std::uint8_t* rows) const;
+
+  /**
+   * Rendering kernel selected once by the constructor; for a chain with a
+   * single orientation, `matrix_orientation` and `upside_down` are fixed at
+   * compile time so that rendering a frame makes no decisions based on the
+   * orientation.
+   */
+  const RenderKernel render_kernel;
+
   /**
    * Intensity (brightness) of the device LEDs.
    */
   char intensity;
 
+  /**
+   * Preallocated buffer holding one command string (a register and data byte
+   * for each matrix in the chain) for each row of the matrices; commands are
+   * built in this buffer so that sending a frame does not allocate memory.
+   */
+  std::vector<char> command_buffer;
+
+  /**
+   * One transaction for each row's command string in `command_buffer`.
+   */
+  std::array<SPITransport::Transaction, MatrixImage::HEIGHT> row_transactions;
+
+  /**
+   * Commands that configure and blank the device, built and sent as one
+   * batch by the constructor.
+   */
+  CommandSequence startup_sequence;
+
+  /**
+   * Commands that blank and shut down the device, built by the constructor
+   * and sent as one batch by the destructor.
+   */
+  CommandSequence shutdown_sequence;
+
+  /**
+   * Row data last latched into each chip of the device, stored row-major
+   * (index `row * length + matrix`); used to skip sending data that the
+   * device is already displaying.
+   */
+  std::vector<std::uint8_t> latched_rows;
+
+  /**
+   * Whether `latched_rows` is known to match the contents of the device.
+   */
+  bool latched_rows_valid;
+
+  /**
+   * Whether frames are sent as deltas against `latched_rows` rather than in
+   * full.
+   */
+  bool delta_transmission;
+
+  /**
+   * Row data (stored like `latched_rows`) of the frame being sent to the
+   * device; owned by the transmit thread in asynchronous mode.
+   */
+  std::vector<std::uint8_t> front_rows;
+
+  /**
+   * Row data of the most recently published frame that has not been picked
+   * up by the transmit thread yet; only used in asynchronous mode.
+   */
+  std::vector<std::uint8_t> back_rows;
+
+  /**
+   * Row data of an image being preprocessed by a chain of modules with
+   * individual transforms.
+   */
+  std::vector<std::uint8_t> preprocess_rows;
+
+  /**
+   * Whether `back_rows` holds a frame that has not been sent yet.
+   */
+  bool frame_pending;
+
+  /**
+   * Number of published frames that were replaced by a newer frame before
+   * they could be sent.
+   */
+  std::uint64_t dropped_frame_count;
+
+  /**
+   * Guards the transport, the command buffer and the latched row state.
+   */
+  std::mutex bus_mutex;
+
+  /**
+   * Guards `back_rows`, `frame_pending`, `dropped_frame_count`,
+   * `stop_requested` and `transmit_error`.
+   */
+  mutable std::mutex frame_mutex;
+
+  /**
+   * Signals the transmit thread that a frame was published or that it
+   * should stop.
+   */
+  std::condition_variable frame_ready;
+
+  /**
+   * Background thread that owns the bus in asynchronous mode.
+   */
+  std::thread transmit_thread;
+
+  /**
+   * Whether frames are handed off to the transmit thread.
+   */
+  bool async_mode;
+
+  /**
+   * Whether the transmit thread has been asked to exit.
+   */
+  bool stop_requested;
+
+  /**
+   * Exception thrown while the transmit thread was sending a frame, which
+   * stopped the thread; reported by the next call that publishes a frame,
+   * stops asynchronous mode or forces a full refresh.
+   */
+  std::exception_ptr transmit_error;
+
 public:
 
   /**
@@ -48,31 +277,326 @@ public:
   MAX7219Chain& operator=(const MAX7219Chain&) = delete;
   MAX7219Chain& operator=(MAX7219Chain&&) = delete;
 
+  /**
+   * @brief Constructs a chain that sends commands through the Raspberry Pi
+   *        SPI0 peripheral using the bcm2835 library.
+   * 
+   * @param length number of 8x8 LED matrices in the device
+   * @param matrix_orientation number of 90 degree clockwise rotations to make
+   *                           to each 8x8 matrix
+   * @param upside_down whether the physical device is mounted upside down
+   * @param intensity brightness of the device LEDs
+   * @param warm_start whether the device is already configured and showing
+   *                   content, in which case it is not shut down or blanked
+   *                   during initialization
+   * @throws std::runtime_error if the SPI transport cannot be initialized
+   */
   MAX7219Chain(std::size_t length, std::size_t matrix_orientation,
-               bool upside_down, char intensity);
+               bool upside_down, char intensity, bool warm_start = false);
+
+  /**
+   * @brief Constructs a chain that sends commands through the supplied
+   *        transport.
+   * 
+   * The transport is initialized by the constructor and closed by the
+   * destructor, or by the constructor if it throws, and it must outlive the
+   * chain.
+   * 
+   * @param transport SPI bus used to send commands to the device
+   * @param length number of 8x8 LED matrices in the device
+   * @param matrix_orientation number of 90 degree clockwise rotations to make
+   *                           to each 8x8 matrix
+   * @param upside_down whether the physical device is mounted upside down
+   * @param intensity brightness of the device LEDs
+   * @param warm_start whether the device is already configured and showing
+   *                   content, in which case it is not shut down or blanked
+   *                   during initialization
+   * @throws std::runtime_error if the SPI transport cannot be initialized
+   */
+  MAX7219Chain(SPITransport& transport, std::size_t length,
+               std::size_t matrix_orientation, bool upside_down,
+               char intensity, bool warm_start = false);
+
+  /**
+   * @brief Constructs a chain of modules with individual transforms that
+   *        sends commands through the Raspberry Pi SPI0 peripheral using the
+   *        bcm2835 library.
+   * 
+   * @param module_transforms transform of the section of an image at each
+   *                          matrix index; the positions must name every
+   *                          matrix in the chain exactly once
+   * @param intensity brightness of the device LEDs
+   * @param warm_start whether the device is already configured and showing
+   *                   content, in which case it is not shut down or blanked
+   *                   during initialization
+   * @throws std::runtime_error if the SPI transport cannot be initialized
+   */
+  MAX7219Chain(const std::vector<ModuleTransform>& module_transforms,
+               char intensity, bool warm_start = false);
+
+  /**
+   * @brief Constructs a chain of modules with individual transforms that
+   *        sends commands through the supplied transport.
+   * 
+   * The transport is initialized by the constructor and closed by the
+   * destructor, or by the constructor if it throws, and it must outlive the
+   * chain.
+   * 
+   * @param transport SPI bus used to send commands to the device
+   * @param module_transforms transform of the section of an image at each
+   *                          matrix index; the positions must name every
+   *                          matrix in the chain exactly once
+   * @param intensity brightness of the device LEDs
+   * @param warm_start whether the device is already configured and showing
+   *                   content, in which case it is not shut down or blanked
+   *                   during initialization
+   * @throws std::runtime_error if the SPI transport cannot be initialized
+   */
+  MAX7219Chain(SPITransport& transport,
+               const std::vector<ModuleTransform>& module_transforms,
+               char intensity, bool warm_start = false);
 
   ~MAX7219Chain();
 
   void set_intensity(char intensity); //
-  void display_raw(MatrixChainImage& image); //
-  void display(MatrixChainImage& image);
+  void display_raw(const MatrixChainImage& image); //
+  void display(const MatrixChainImage& image);
+
+  /**
+   * @brief Displays the section of an image that starts at the specified
+   *        column.
+   * 
+   * The device's orientation is applied while the image is read, in a single
+   * pass straight into the row data that is sent to the device, so the image
+   * is neither copied nor modified. Columns beyond the right edge of the
+   * image are blank.
+   * 
+   * @param image image to display
+   * @param column_offset column of the image shown on the first matrix
+   */
+  void display(const MatrixChainImage& image, std::size_t column_offset);
+
+  /**
+   * @brief Displays a view of an image.
+   * 
+   * The view is shown from its first column; columns beyond its width are
+   * blank. Like `display(image, column_offset)`, the viewed image is read
+   * directly without being copied.
+   * 
+   * @param view view of the image to display
+   */
+  void display(const ChainImageView& view);
+
+  /**
+   * @brief Displays a frame that was recorded into a frame store.
+   * 
+   * The stored row data is already oriented for the device, so it is sent
+   * as it is, with the row registers added while the commands are built.
+   * Like any other frame, rows that the device already displays are skipped
+   * when delta transmission is enabled.
+   * 
+   * @param store frames recorded for this chain
+   * @param frame index of the frame to display
+   * 
+   * @throws std::invalid_argument if the frames were recorded for a chain of
+   *         a different length or module transform table
+   * @throws std::out_of_range if there is no frame with the specified index
+   */
+  void display(const FrameStore& store, std::size_t frame);
+
+  /**
+   * @brief Orients and serializes a view of an image, exactly as `display()`
+   *        would, and appends the resulting row data to a frame store
+   *        instead of sending it.
+   * 
+   * An empty store takes on the module transform table of the chain, so
+   * that its frames can only be displayed by chains built the same way.
+   * 
+   * @param view view of the image to record
+   * @param store frames recorded for this chain
+   * 
+   * @throws std::invalid_argument if the store holds frames for a chain of a
+   *         different length or module transform table
+   */
+  void record_frame(const ChainImageView& view, FrameStore& store) const;
+
+  /**
+   * @brief Displays the frame of a frame file most recently decoded by a
+   *        decoder.
+   * 
+   * @param decoder decoder of frames recorded for this chain
+   * 
+   * @throws std::invalid_argument if the frames were recorded for a chain of
+   *         a different length, orientation or module transform table
+   */
+  void display(const FrameDecoder& decoder);
+
+  /**
+   * @brief Returns the number of 8x8 matrices in the chain.
+   * 
+   * @return chain length in matrices
+   */
+  std::size_t get_length() const;
+
+  /**
+   * @brief Returns the number of 90 degree clockwise rotations made to each
+   *        matrix; `0` for a chain of modules with individual transforms.
+   * 
+   * @return matrix orientation of the chain
+   */
+  std::size_t get_matrix_orientation() const;
+
+  /**
+   * @brief Returns whether the chain is mounted upside down; `false` for a
+   *        chain of modules with individual transforms.
+   * 
+   * @return `true` if the chain is upside down
+   */
+  bool is_upside_down() const;
+
+  /**
+   * @brief Returns the identifier of the module transform table that the
+   *        chain was built from; `0` for a chain with a single orientation.
+   * 
+   * @return transform table identifier of the chain
+   */
+  std::uint64_t get_transform_table_id() const;
   void clear(); //
+
+  /**
+   * @brief Enables or disables delta transmission of frames.
+   * 
+   * With delta transmission enabled, a row whose data is unchanged on every
+   * chip is not sent at all, and chips whose data is unchanged in a row that
+   * is sent receive a `NO_OP` command instead of their row data.
+   * 
+   * @param enabled whether to send frames as deltas (enabled by default)
+   */
+  void set_delta_transmission(bool enabled);
+
+  /**
+   * @brief Starts a background thread that transmits frames so that
+   *        `display()` and `display_raw()` return without waiting for the
+   *        bus.
+   * 
+   * In asynchronous mode, displaying an image only publishes the finished
+   * frame to the transmit thread. If a new frame is published before the
+   * previous one has been picked up, the previous frame is dropped so that
+   * the latest frame is always the one shown. Frames must be published from
+   * a single thread.
+   * 
+   * If sending a frame fails, the transmit thread stops and the chain
+   * returns to synchronous mode the next time a frame is published,
+   * `stop_async()` is called or a full refresh is forced, which then throws
+   * the exception that the transport threw. These calls must be made from
+   * the thread that publishes frames.
+   */
+  void start_async();
+
+  /**
+   * @brief Sends any frame that is still pending and stops the background
+   *        transmit thread; frames are then sent synchronously again.
+   * 
+   * @throws any exception thrown by the transport on the transmit thread
+   *         that has not been reported yet
+   */
+  void stop_async();
+
+  /**
+   * @brief Returns whether frames are being sent by a background thread.
+   * 
+   * @return `true` if asynchronous mode is active
+   */
+  bool is_async() const;
+
+  /**
+   * @brief Returns the number of frames that were replaced by a newer frame
+   *        before the transmit thread could send them.
+   * 
+   * @return number of dropped frames
+   */
+  std::uint64_t get_dropped_frame_count() const;
+
+  /**
+   * @brief Forces every row of the next frame to be sent to every chip, e.g.
+   *        after the device may have been disturbed by a power glitch.
+   * 
+   * @throws any exception thrown by the transport on the transmit thread
+   *         that has not been reported yet
+   */
+  void force_full_refresh();
   void show(); //
   void hide(); //
   void preprocess(MatrixChainImage& image); //
-  static std::vector<std::vector<char>*>* image_to_command_vectors(
-      MatrixChainImage* image);
-  std::vector<std::vector<char>*>* generate_frame(MatrixChainImage* image);
-  void send_command_vectors(std::vector<std::vector<char>*>* command_vectors);
+  static std::vector<std::vector<char>> image_to_command_vectors(
+      const MatrixChainImage& image);
+  std::vector<std::vector<char>> generate_frame(const MatrixChainImage& image);
+  void send_command_vectors(std::vector<std::vector<char>>& command_vectors);
 
 private:
 
+  /**
+   * @brief Constructor that every public constructor delegates to, with the
+   *        transform plan and kernels already compiled.
+   * 
+   * @param owned_transport transport created for the chain, or `nullptr`
+   * @param shared_transport transport supplied by the caller, or `nullptr`
+   *                         to use `owned_transport`
+   */
+  MAX7219Chain(std::unique_ptr<SPITransport> owned_transport,
+               SPITransport* shared_transport, std::size_t length,
+               std::size_t matrix_orientation, bool upside_down,
+               std::vector<ModulePlan> transform_plan,
+               RenderKernel render_kernel, char intensity, bool warm_start);
+  void initialize(bool warm_start);
+  void append_command_all(CommandSequence& sequence,
+                          MAX7219Register device_register, char data) const;
+  void append_command_all(CommandSequence& sequence, char register_value,
+                          char data) const;
+  void finalize_sequence(CommandSequence& sequence) const;
+  void send_sequence(CommandSequence& sequence);
   void send_command_all(MAX7219Register device_register, char data); //
   void send_command_all(char register_value, char data);
-  void send_command_string(std::vector<char>* command_string); //
+  template <typename Fill>
+  void send_frame(Fill fill);
+  void send_stored_rows(const std::uint8_t* stored_rows);
+  void check_recorded_length(std::size_t recorded_length) const;
+  void check_recorded_transform_table(std::uint64_t recorded_id) const;
+  void transmit_rows(const std::uint8_t* rows);
+  void transmit_loop();
+  void report_transmit_error();
+  template <std::size_t ROTATION, bool UPSIDE_DOWN>
+  void render_rows(const ChainImageView& view, std::uint8_t* rows) const;
+  void render_planned(const ChainImageView& view, std::uint8_t* rows) const;
+  void store_matrix_rows(std::uint64_t word, std::size_t matrix,
+                         std::uint8_t* rows) const;
+  static RenderKernel select_render_kernel(std::size_t matrix_orientation,
+                                           bool upside_down);
+  static std::vector<ModulePlan> compile_transform_plan(
+      std::size_t length, std::size_t matrix_orientation, bool upside_down);
+  static std::vector<ModulePlan> compile_transform_plan(
+      const std::vector<ModuleTransform>& module_transforms);
+  static std::uint64_t hash_transform_plan(
+      const std::vector<ModulePlan>& transform_plan);
   static std::size_t row_register_to_row_index(char device_register); //
   static char row_index_to_row_register(std::size_t index); //
 
 };
 
+inline std::size_t MAX7219Chain::get_length() const {
+  return length;
+}
+
+inline std::size_t MAX7219Chain::get_matrix_orientation() const {
+  return matrix_orientation;
+}
+
+inline bool MAX7219Chain::is_upside_down() const {
+  return upside_down;
+}
+
+inline std::uint64_t MAX7219Chain::get_transform_table_id() const {
+  return transform_table_id;
+}
+
 #endif  // MAX7219_CHAIN_H_
\ No newline at end of file
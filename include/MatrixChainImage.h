@@ -9,6 +9,8 @@
 
 #include <vector>
 #include <cstdint>
+#include <string>
+#include <stdexcept>
 
 #include "MatrixImage.h"
 #include "Font.h"
@@ -48,6 +50,11 @@
  */
 class MatrixChainImage {
 
+  /**
+   * Views read rows of the image directly from its words.
+   */
+  friend class ChainImageView;
+
 public:  // public data members
 
   /**
@@ -59,9 +66,20 @@ public:  // public data members
 private:  // private data members
 
   /**
-   * Image data is stored in individual `MatrixImage`s.
+   * Number of 64-bit words used to store each row of the image; each word
+   * holds one row of eight consecutive `MatrixImage`s.
+   */
+  const std::size_t words_per_row;
+
+  /**
+   * Image data is stored as a single contiguous bit-plane of 64-bit words in
+   * row-major order; row `r` is held in words `r * words_per_row` through
+   * `(r + 1) * words_per_row - 1`. Within a row, column `0` is the most-
+   * significant bit of the first word, so each byte of a word holds one row
+   * of a `MatrixImage` with the lowest matrix index in the most-significant
+   * byte. Bits beyond the width of the image are always `0`.
    */
-  std::vector<MatrixImage*> matrices;
+  std::vector<std::uint64_t> image_data;
 
   /**
    * Position (column) at which subsequent characters will be added when
@@ -73,25 +91,36 @@ public:  // public methods
 
   /**
    * Deletion of functions that could potentially be implicitly declared in
-   * order to prevent errors from accidental use.
+   * order to prevent errors from accidental use; images cannot be assigned
+   * because the length of an image never changes.
    */
   MatrixChainImage() = delete;
-  MatrixChainImage(const MatrixChainImage&) = delete;
-  MatrixChainImage(MatrixChainImage&&) = delete;
   MatrixChainImage& operator=(const MatrixChainImage&) = delete;
   MatrixChainImage& operator=(MatrixChainImage&&) = delete;
 
   /**
-   * @brief Constructs a blank image of the specified length in matrices.
+   * @brief Constructs an image with the same data as another image (deep
+   *        copy).
    * 
-   * @param length number of 8x8 `MatrixImage`s that make up this image
+   * @param image_to_copy image to copy
    */
-  MatrixChainImage(std::size_t length);
+  MatrixChainImage(const MatrixChainImage& image_to_copy) = default;
 
   /**
-   * @brief `MatrixChainImage` destructor.
+   * @brief Constructs an image that takes over the data of another image
+   *        without copying it; the other image is left blank, with the same
+   *        length, so that it can still be used.
+   * 
+   * @param image_to_move image to move from
    */
-  ~MatrixChainImage();
+  MatrixChainImage(MatrixChainImage&& image_to_move);
+
+  /**
+   * @brief Constructs a blank image of the specified length in matrices.
+   * 
+   * @param length number of 8x8 `MatrixImage`s that make up this image
+   */
+  MatrixChainImage(std::size_t length);
 
   /**
    * @brief Sets the pixel at the specified position, in the context of the
@@ -127,6 +156,17 @@ public:  // public methods
   std::uint_fast8_t get_row_of_matrix(std::size_t matrix,
                                       std::size_t row) const;
 
+  /**
+   * @brief Sets the data for an entire row of a specified matrix within the
+   * image.
+   * 
+   * @param matrix index of the matrix within this image to set data for
+   * @param row row for which to set image data
+   * @param value value to store as the data for the specified row and matrix
+   */
+  void set_row_of_matrix(std::size_t matrix, std::size_t row,
+                         std::uint_fast8_t value);
+
   /**
    * @brief Returns the width of the image in pixels.
    * 
@@ -145,10 +185,43 @@ public:  // public methods
   std::string draw_text(const std::string& text, Font& font);
 
   /**
-   * @brief Move each pixel one pixel to the left - creates scrolling visual
-   *        effect if called successively at constant intervals.
+   * @brief Draws the character with the specified UTF-8 code point onto
+   *        this image at the specified position.
+   * 
+   * @param code_point UTF-8 code point of the character to be drawn
+   * @param position column of the image at which to begin drawing
+   * @param font font to use to draw the character
+   * 
+   * @throws std::out_of_range if the glyph does not fit on the image
+   */
+  void draw_character(std::uint_fast8_t code_point, std::size_t position,
+                      Font& font);
+
+  /**
+   * @brief Sets every pixel of this image off and moves the cursor back to
+   *        the first column.
+   */
+  void clear();
+
+  /**
+   * @brief Move each pixel one or more pixels to the left - creates scrolling
+   *        visual effect if called successively at constant intervals.
+   * 
+   * Rows are shifted 64 columns at a time, so the cost of a shift depends on
+   * the length of the image but not on the number of columns shifted.
+   * Columns of 0's are added on the rightmost edge.
+   * 
+   * @param columns number of columns by which to shift the image
    */
-  void left_shift_image();
+  void left_shift_image(std::size_t columns = 1);
+
+  /**
+   * @brief Move each pixel one or more pixels to the right; columns of 0's
+   *        are added on the leftmost edge.
+   * 
+   * @param columns number of columns by which to shift the image
+   */
+  void right_shift_image(std::size_t columns = 1);
 
   /**
    * @brief Transform this image into one in which each 8x8 section of the
@@ -160,6 +233,21 @@ public:  // public methods
    */
   void rotate_matrices(std::size_t rotation);
 
+  /**
+   * @brief Transform this image by applying the specified word transform to
+   *        each 8x8 section of the image.
+   * 
+   * Eight sections at a time are gathered into 64-bit words, transformed,
+   * and scattered back, so the whole chain is processed in a single pass.
+   * 
+   * @tparam Transform callable that takes and returns a `std::uint64_t`;
+   *                   passing a lambda lets the transform be inlined
+   * @param transform transform to apply to each 8x8 section, e.g. one of the
+   *                  rotations or flips provided by `MatrixImage`
+   */
+  template <typename Transform>
+  void transform_matrices(Transform transform);
+
   /**
    * @brief Transform this image by rotating it 180 (or 0) degrees.
    * 
@@ -169,12 +257,57 @@ public:  // public methods
 
   /**
    * Create a cropped version of this image that is made up of `length` 8x8
-   * `MatrixImage`s (deep copy).
+   * `MatrixImage`s (deep copy). To show part of an image without copying it,
+   * use a `ChainImageView` instead.
    * 
    * @param length length of the cropped image in `MatrixImage`s (8x8 images)
-   * @return pointer to a new chain image
+   * @return new chain image
+   */
+  MatrixChainImage get_cropped_image(std::size_t length) const;
+
+  /**
+   * Copy the first `cropped_image.length` 8x8 `MatrixImage`s of this image
+   * into an existing image without allocating memory.
+   * 
+   * @param cropped_image image into which to copy the cropped image data
+   */
+  void get_cropped_image(MatrixChainImage& cropped_image) const;
+
+  /**
+   * @brief Copy a window of this image that starts at any column into an
+   *        existing image without allocating memory.
+   * 
+   * The window is as wide as `window`. Columns of the window that lie beyond
+   * the right edge of this image are blank, or, if `wrap` is `true`, are
+   * taken from the start of this image again so that the image repeats
+   * seamlessly.
+   * 
+   * @param window image into which to copy the window
+   * @param column_offset column of this image at which the window starts
+   * @param wrap whether the window wraps around to the start of this image
+   */
+  void get_window(MatrixChainImage& window, std::size_t column_offset,
+                  bool wrap = false) const;
+
+  /**
+   * @brief Returns the number of matrices an image needs in order to hold
+   *        the specified text in its entirety.
+   * 
+   * @param text string that would be drawn onto the image
+   * @param font font that would be used to draw the text
+   * @return smallest image length that fits the text
    */
-  MatrixChainImage* get_cropped_image(std::size_t length);
+  static std::size_t get_text_length(const std::string& text, Font& font);
+
+  /**
+   * @brief Returns the number of columns the specified text takes up when it
+   *        is drawn.
+   * 
+   * @param text string that would be drawn onto an image
+   * @param font font that would be used to draw the text
+   * @return width of the text in pixels
+   */
+  static std::size_t get_text_width(const std::string& text, Font& font);
 
 private:  // private methods
 
@@ -204,17 +337,6 @@ private:  // private methods
   std::uint_fast8_t get_pixel(std::size_t matrix, std::size_t row, 
                               std::size_t col) const;
 
-  /**
-   * @brief Sets the data for an entire row of a specified matrix within the
-   * image.
-   * 
-   * @param matrix index of the matrix within this image to set data for
-   * @param row row for which to set image data
-   * @param value value to store as the data for the specified row and matrix
-   */
-  void set_row_of_matrix(std::size_t matrix, std::size_t row,
-                         std::uint_fast8_t value);
-
   /**
    * @brief Draws the character with the specified UTF-8 code point onto
    *        this image at the current cursor position.
@@ -228,34 +350,229 @@ private:  // private methods
   void draw_character(std::uint_fast8_t code_point, Font& font);
 
   /**
-   * @brief Draws the character with the specified UTF-8 code point onto
-   *        this image at the specified position.
+   * @brief Replaces the masked columns of a row of a specified matrix with
+   *        the corresponding bits of a value; no bounds checking is done.
    * 
-   * @param code_point UTF-8 code point of the character to be drawn
-   * @param position column of the image at which to begin drawing
-   * @param font font to use to draw the character
+   * @param matrix index of the matrix within this image
+   * @param row row of the matrix
+   * @param value row data to write
+   * @param mask columns of the row to replace
    */
-  void draw_character(std::uint_fast8_t code_point, std::size_t position,
-                      Font& font);
+  void write_row_of_matrix(std::size_t matrix, std::size_t row,
+                           std::uint8_t value, std::uint8_t mask);
+
+  /**
+   * @brief Returns the position of the word that holds the specified row of
+   *        the specified matrix within `image_data`.
+   * 
+   * @param matrix index of the matrix within this image
+   * @param row row of the matrix
+   * @return index into `image_data`
+   */
+  std::size_t word_index(std::size_t matrix, std::size_t row) const;
+
+  /**
+   * @brief Returns the number of bits that a matrix row is shifted by within
+   *        its word.
+   * 
+   * @param matrix index of the matrix within this image
+   * @return left-shift amount of the matrix's byte within its word
+   */
+  static unsigned int byte_shift(std::size_t matrix);
+
+  /**
+   * @brief Shifts a row of image data to the left by any number of columns.
+   * 
+   * @param row_data first word of the row to shift
+   * @param columns number of columns by which to shift the row
+   */
+  void shift_row_left(std::uint64_t* row_data, std::size_t columns) const;
+
+  /**
+   * @brief Shifts a row of image data to the right by any number of columns.
+   * 
+   * @param row_data first word of the row to shift
+   * @param columns number of columns by which to shift the row
+   */
+  void shift_row_right(std::uint64_t* row_data, std::size_t columns) const;
+
+  /**
+   * @brief Returns 64 consecutive columns of a row of this image.
+   * 
+   * @param row row of the image to read from
+   * @param column column of the first bit to return
+   * @return the specified columns with the first column in the most-
+   *         significant bit; columns beyond the image are `0`
+   */
+  std::uint64_t read_row_bits(std::size_t row, std::size_t column) const;
+
+  /**
+   * @brief Returns a mask of the bits of the last word of each row that are
+   *        within the width of the image.
+   * 
+   * @return mask with a bit set for each column of the last word in use
+   */
+  std::uint64_t last_word_mask() const;
+
+  /**
+   * @brief Throws an exception if the specified matrix or row does not exist
+   *        in this image.
+   * 
+   * @param matrix index of the matrix within this image
+   * @param row row of the matrix
+   */
+  void check_bounds(std::size_t matrix, std::size_t row) const;
+
+  /**
+   * @brief Transposes eight 64-bit words as an 8x8 matrix of bytes.
+   * 
+   * Given the eight row words that hold eight consecutive matrices, the
+   * result holds one whole matrix per word, laid out as described for
+   * `MatrixImage::get_word()`; applying it again restores the row words.
+   * 
+   * @param words eight words to transpose in place
+   */
+  static void transpose_bytes(std::uint64_t* words);
 
 };  // class MatrixChainImage
 
 inline MatrixChainImage::MatrixChainImage(std::size_t length)
   : length{length}
-  , matrices(length, nullptr)
-  , cursor_position{0} {
+  , words_per_row{(length + 7) / 8}
+  , image_data(MatrixImage::HEIGHT * words_per_row, 0)
+  , cursor_position{0} { /* no body */ }
+
+inline MatrixChainImage::MatrixChainImage(MatrixChainImage&& image_to_move)
+  : length{image_to_move.length}
+  , words_per_row{image_to_move.words_per_row}
+  , image_data(image_to_move.image_data.size(), 0)
+  , cursor_position{image_to_move.cursor_position} {
+
+  // the length of the other image cannot change, so it is given the blank
+  // buffer in exchange for its data rather than being left with none
+  image_data.swap(image_to_move.image_data);
+  image_to_move.cursor_position = 0;
+}
+
+inline std::size_t MatrixChainImage::word_index(std::size_t matrix,
+                                                std::size_t row) const {
+  return row * words_per_row + matrix / 8;
+}
+
+inline void MatrixChainImage::write_row_of_matrix(std::size_t matrix,
+                                                  std::size_t row,
+                                                  std::uint8_t value,
+                                                  std::uint8_t mask) {
+
+  std::uint64_t& word = image_data[word_index(matrix, row)];
+  unsigned int shift{byte_shift(matrix)};
+  word = (word & ~(static_cast<std::uint64_t>(mask) << shift))
+    | (static_cast<std::uint64_t>(value & mask) << shift);
+}
+
+inline unsigned int MatrixChainImage::byte_shift(std::size_t matrix) {
+  return 56 - 8 * (matrix % 8);
+}
+
+inline std::uint64_t MatrixChainImage::read_row_bits(
+    std::size_t row, std::size_t column) const {
+
+  const std::uint64_t* row_data = image_data.data() + row * words_per_row;
+  std::size_t word{column / 64};
+  unsigned int bit_shift{static_cast<unsigned int>(column % 64)};
+
+  std::uint64_t high{word < words_per_row ? row_data[word] : 0};
+  std::uint64_t low{word + 1 < words_per_row ? row_data[word + 1] : 0};
 
-  // fill the array of `MatrixImage`s with blank images
-  for (std::size_t i = 0; i < this->length; i++) {
-    matrices.at(i) = new MatrixImage();
+  return bit_shift == 0
+    ? high
+    : (high << bit_shift) | (low >> (64 - bit_shift));
+}
+
+inline void MatrixChainImage::transpose_bytes(std::uint64_t* words) {
+
+  // swap the 4x4, then 2x2, then 1x1 blocks of bytes across the diagonal
+  for (std::size_t i = 0; i < 4; i++) {
+    std::uint64_t a{words[i]};
+    std::uint64_t b{words[i + 4]};
+    words[i] = (a & 0xFFFFFFFF00000000ULL) | (b >> 32);
+    words[i + 4] = (b & 0x00000000FFFFFFFFULL) | (a << 32);
+  }
+  for (std::size_t i : {0, 1, 4, 5}) {
+    std::uint64_t a{words[i]};
+    std::uint64_t b{words[i + 2]};
+    words[i] = (a & 0xFFFF0000FFFF0000ULL) | ((b >> 16) & 0x0000FFFF0000FFFFULL);
+    words[i + 2] =
+      (b & 0x0000FFFF0000FFFFULL) | ((a << 16) & 0xFFFF0000FFFF0000ULL);
+  }
+  for (std::size_t i : {0, 2, 4, 6}) {
+    std::uint64_t a{words[i]};
+    std::uint64_t b{words[i + 1]};
+    words[i] = (a & 0xFF00FF00FF00FF00ULL) | ((b >> 8) & 0x00FF00FF00FF00FFULL);
+    words[i + 1] =
+      (b & 0x00FF00FF00FF00FFULL) | ((a << 8) & 0xFF00FF00FF00FF00ULL);
+  }
+}
+
+template <typename Transform>
+inline void MatrixChainImage::transform_matrices(Transform transform) {
+
+  // for each group of eight matrices, gather the group's row words so that
+  // each word holds one matrix, transform every matrix, and scatter the
+  // words back into rows; the blank matrices that pad the last group stay
+  // blank under any rotation or flip
+  for (std::size_t group = 0; group < words_per_row; group++) {
+
+    std::uint64_t words[MatrixImage::HEIGHT];
+    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+      words[row] = image_data[row * words_per_row + group];
+    }
+
+    transpose_bytes(words);
+    for (std::uint64_t& word : words) {
+      word = transform(word);
+    }
+    transpose_bytes(words);
+
+    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+      image_data[row * words_per_row + group] = words[row];
+    }
+  }
+
+  // a transform could move pixels into the padding of a partial group
+  if (words_per_row != 0) {
+    std::uint64_t mask{last_word_mask()};
+    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+      image_data[(row + 1) * words_per_row - 1] &= mask;
+    }
   }
+}
 
+inline std::uint64_t MatrixChainImage::last_word_mask() const {
+  return ~std::uint64_t{0} << (64 * words_per_row - get_pixel_width());
 }
 
-inline MatrixChainImage::~MatrixChainImage() {
-  for (std::size_t i = 0; i < matrices.size(); i++) {
-    // free memory allocated for image components
-    delete matrices.at(i);
+inline void MatrixChainImage::check_bounds(std::size_t matrix,
+                                           std::size_t row) const {
+
+  // throw an exception if the matrix index provided is invalid
+  if (matrix >= length) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "matrix index must be less than image length of "
+      + std::to_string(length) + "; provided value was "
+      + std::to_string(matrix)
+    };
+  }
+
+  // throw an exception if the row index provided is invalid
+  if (row >= MatrixImage::HEIGHT) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "row index must be less than matrix height of "
+      + std::to_string(MatrixImage::HEIGHT) + "; provided value was "
+      + std::to_string(row)
+    };
   }
 }
 
@@ -269,7 +586,17 @@ inline void MatrixChainImage::set_pixel(std::size_t matrix, std::size_t row,
                                         std::size_t col, 
                                         std::uint_fast8_t value) {
 
-  matrices.at(matrix)->set_pixel(row, col, value);
+  check_bounds(matrix, row);
+
+  std::uint64_t mask{
+    std::uint64_t{1} << (byte_shift(matrix) + MatrixImage::WIDTH - 1 - col)};
+
+  // set or unset the pixel depending on the boolean value of value
+  if (value) {
+    image_data[word_index(matrix, row)] |= mask;
+  } else {
+    image_data[word_index(matrix, row)] &= ~mask;
+  }
 }
 
 inline std::uint_fast8_t MatrixChainImage::get_pixel(std::size_t row,
@@ -281,7 +608,8 @@ inline std::uint_fast8_t MatrixChainImage::get_pixel(std::size_t row,
 inline std::uint_fast8_t MatrixChainImage::get_row_of_matrix(
       std::size_t matrix, std::size_t row) const {
 
-  return matrices.at(matrix)->get_row(row);
+  check_bounds(matrix, row);
+  return (image_data[word_index(matrix, row)] >> byte_shift(matrix)) & 0xFF;
 }
 
 inline std::size_t MatrixChainImage::get_pixel_width() const {
@@ -291,14 +619,21 @@ inline std::size_t MatrixChainImage::get_pixel_width() const {
 inline std::uint_fast8_t MatrixChainImage::get_pixel(std::size_t matrix, 
                                                      std::size_t row,
                                                      std::size_t col) const {
-  return matrices.at(matrix)->get_pixel(row, col);
+
+  check_bounds(matrix, row);
+  return (image_data[word_index(matrix, row)]
+          >> (byte_shift(matrix) + MatrixImage::WIDTH - 1 - col)) & 1;
 }
 
 inline void MatrixChainImage::set_row_of_matrix(std::size_t matrix, 
                                                 std::size_t row,
                                                 std::uint_fast8_t value) {
   
-  matrices.at(matrix)->set_row(row, value);
+  check_bounds(matrix, row);
+
+  std::uint64_t& word = image_data[word_index(matrix, row)];
+  word &= ~(std::uint64_t{0xFF} << byte_shift(matrix));
+  word |= static_cast<std::uint64_t>(value & 0xFF) << byte_shift(matrix);
 }
 
 #endif  // SCROLLER_MATRIX_CHAIN_IMAGE_H_
@@ -12,7 +12,9 @@
 #include <memory>
 #include <climits>
 #include <exception>
+#include <stdexcept>
 #include <string>
+#include <functional>
 
 /**
  * @brief An monochrome image that can be displayed on an 8x8 LED Matrix.
@@ -55,103 +57,50 @@ public:  // (constant) public data members
    */
   static const std::size_t WIDTH{8};
 
-  static constexpr std::uint_fast8_t reverse_bits_lookup_table[]{
-    0b00000000, 0b10000000, 0b01000000, 0b11000000,
-    0b00100000, 0b10100000, 0b01100000, 0b11100000,
-    0b00010000, 0b10010000, 0b01010000, 0b11010000,
-    0b00110000, 0b10110000, 0b01110000, 0b11110000,
-    0b00001000, 0b10001000, 0b01001000, 0b11001000,
-    0b00101000, 0b10101000, 0b01101000, 0b11101000,
-    0b00011000, 0b10011000, 0b01011000, 0b11011000,
-    0b00111000, 0b10111000, 0b01111000, 0b11111000,
-    0b00000100, 0b10000100, 0b01000100, 0b11000100,
-    0b00100100, 0b10100100, 0b01100100, 0b11100100,
-    0b00010100, 0b10010100, 0b01010100, 0b11010100,
-    0b00110100, 0b10110100, 0b01110100, 0b11110100,
-    0b00001100, 0b10001100, 0b01001100, 0b11001100,
-    0b00101100, 0b10101100, 0b01101100, 0b11101100,
-    0b00011100, 0b10011100, 0b01011100, 0b11011100,
-    0b00111100, 0b10111100, 0b01111100, 0b11111100,
-    0b00000010, 0b10000010, 0b01000010, 0b11000010,
-    0b00100010, 0b10100010, 0b01100010, 0b11100010,
-    0b00010010, 0b10010010, 0b01010010, 0b11010010,
-    0b00110010, 0b10110010, 0b01110010, 0b11110010,
-    0b00001010, 0b10001010, 0b01001010, 0b11001010,
-    0b00101010, 0b10101010, 0b01101010, 0b11101010,
-    0b00011010, 0b10011010, 0b01011010, 0b11011010,
-    0b00111010, 0b10111010, 0b01111010, 0b11111010,
-    0b00000110, 0b10000110, 0b01000110, 0b11000110,
-    0b00100110, 0b10100110, 0b01100110, 0b11100110,
-    0b00010110, 0b10010110, 0b01010110, 0b11010110,
-    0b00110110, 0b10110110, 0b01110110, 0b11110110,
-    0b00001110, 0b10001110, 0b01001110, 0b11001110,
-    0b00101110, 0b10101110, 0b01101110, 0b11101110,
-    0b00011110, 0b10011110, 0b01011110, 0b11011110,
-    0b00111110, 0b10111110, 0b01111110, 0b11111110,
-    0b00000001, 0b10000001, 0b01000001, 0b11000001,
-    0b00100001, 0b10100001, 0b01100001, 0b11100001,
-    0b00010001, 0b10010001, 0b01010001, 0b11010001,
-    0b00110001, 0b10110001, 0b01110001, 0b11110001,
-    0b00001001, 0b10001001, 0b01001001, 0b11001001,
-    0b00101001, 0b10101001, 0b01101001, 0b11101001,
-    0b00011001, 0b10011001, 0b01011001, 0b11011001,
-    0b00111001, 0b10111001, 0b01111001, 0b11111001,
-    0b00000101, 0b10000101, 0b01000101, 0b11000101,
-    0b00100101, 0b10100101, 0b01100101, 0b11100101,
-    0b00010101, 0b10010101, 0b01010101, 0b11010101,
-    0b00110101, 0b10110101, 0b01110101, 0b11110101,
-    0b00001101, 0b10001101, 0b01001101, 0b11001101,
-    0b00101101, 0b10101101, 0b01101101, 0b11101101,
-    0b00011101, 0b10011101, 0b01011101, 0b11011101,
-    0b00111101, 0b10111101, 0b01111101, 0b11111101,
-    0b00000011, 0b10000011, 0b01000011, 0b11000011,
-    0b00100011, 0b10100011, 0b01100011, 0b11100011,
-    0b00010011, 0b10010011, 0b01010011, 0b11010011,
-    0b00110011, 0b10110011, 0b01110011, 0b11110011,
-    0b00001011, 0b10001011, 0b01001011, 0b11001011,
-    0b00101011, 0b10101011, 0b01101011, 0b11101011,
-    0b00011011, 0b10011011, 0b01011011, 0b11011011,
-    0b00111011, 0b10111011, 0b01111011, 0b11111011,
-    0b00000111, 0b10000111, 0b01000111, 0b11000111,
-    0b00100111, 0b10100111, 0b01100111, 0b11100111,
-    0b00010111, 0b10010111, 0b01010111, 0b11010111,
-    0b00110111, 0b10110111, 0b01110111, 0b11110111,
-    0b00001111, 0b10001111, 0b01001111, 0b11001111,
-    0b00101111, 0b10101111, 0b01101111, 0b11101111,
-    0b00011111, 0b10011111, 0b01011111, 0b11011111,
-    0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
+  /**
+   * Word with the least-significant bit of every row set; multiplying it by
+   * a byte repeats the byte in every row.
+   */
+  static const std::uint64_t ROW_LSB{0x0101010101010101ULL};
 
 private:  // private data members
 
   /**
-   * Image data is stored as an array of 8-bit unsigned integers. The integer
-   * at index `i` represents row `i` and each bit in the integer represents
-   * a column where the most-significant bit represents column index `0`.
+   * Image data is stored as a single 64-bit word. Byte `i`, counting from the
+   * most-significant byte, represents row `i` and each bit in the byte
+   * represents a column where the most-significant bit represents column
+   * index `0`.
    */
-  std::array<std::uint_fast8_t, HEIGHT> image_data;
+  std::uint64_t image_data;
 
 public:  // public methods
 
   /**
-   * Deletion of functions that could potentially be implicitly declared in
-   * order to prevent errors from accidental use.
+   * @brief Default constructor that constructs a blank image.
    */
-  MatrixImage(MatrixImage&&) = delete;
-  MatrixImage& operator=(const MatrixImage&) = delete;
-  MatrixImage& operator=(MatrixImage&&) = delete;
+  MatrixImage();
 
   /**
-   * @brief Default constructor that constructs a blank image.
+   * @brief Constructs an image from a single 64-bit word laid out as
+   *        described for `get_word()`.
+   * 
+   * @param word image data as a 64-bit word
    */
-  MatrixImage();
+  explicit MatrixImage(std::uint64_t word);
 
   /**
    * @brief Construct an image with the same data as another image.
    * 
    * @param image_to_copy A `MatrixImage` object to copy
    */
-  MatrixImage(const MatrixImage& image_to_copy);
+  MatrixImage(const MatrixImage& image_to_copy) = default;
+
+  /**
+   * Images are small value types, so moving an image copies it.
+   */
+  MatrixImage(MatrixImage&&) = default;
+  MatrixImage& operator=(const MatrixImage&) = default;
+  MatrixImage& operator=(MatrixImage&&) = default;
 
   /**
    * @brief Move bits of a row to the left by one place; returns the left-
@@ -211,6 +160,91 @@ public:  // public methods
    */
   void set_row(std::size_t row, std::uint_fast8_t value);
 
+  /**
+   * @brief Returns the data for the entire image as a single 64-bit word.
+   * 
+   * Row `0` is held in the most-significant byte of the word and within each
+   * byte column `0` is held in the most-significant bit.
+   * 
+   * @return image data as a 64-bit word
+   */
+  std::uint64_t get_word() const;
+
+  /**
+   * @brief Sets the data for the entire image from a single 64-bit word laid
+   *        out as described for `get_word()`.
+   * 
+   * @param word image data as a 64-bit word
+   */
+  void set_word(std::uint64_t word);
+
+  /**
+   * @brief Moves every pixel of this image to the left by the specified
+   *        number of columns; pixels moved past the left edge are discarded
+   *        and the columns on the right become blank.
+   * 
+   * @param columns number of columns by which to shift the image
+   */
+  void shift_left(std::size_t columns = 1);
+
+  /**
+   * @brief Moves every pixel of this image to the right by the specified
+   *        number of columns; pixels moved past the right edge are discarded
+   *        and the columns on the left become blank.
+   * 
+   * @param columns number of columns by which to shift the image
+   */
+  void shift_right(std::size_t columns = 1);
+
+  /**
+   * @brief Moves every pixel of this image up by the specified number of
+   *        rows; pixels moved past the top edge are discarded and the rows at
+   *        the bottom become blank.
+   * 
+   * @param rows number of rows by which to shift the image
+   */
+  void shift_up(std::size_t rows = 1);
+
+  /**
+   * @brief Moves every pixel of this image down by the specified number of
+   *        rows; pixels moved past the bottom edge are discarded and the rows
+   *        at the top become blank.
+   * 
+   * @param rows number of rows by which to shift the image
+   */
+  void shift_down(std::size_t rows = 1);
+
+  /**
+   * @brief Returns the number of pixels of this image that are turned on.
+   * 
+   * @return number of pixels set to `1`
+   */
+  std::size_t count_pixels() const;
+
+  /**
+   * @brief Returns whether every pixel of this image is turned off.
+   * 
+   * @return `true` if no pixel is set to `1`
+   */
+  bool is_blank() const;
+
+  /**
+   * @brief Bitwise operators that combine whole images pixel by pixel.
+   */
+  MatrixImage& operator&=(const MatrixImage& image);
+  MatrixImage& operator|=(const MatrixImage& image);
+  MatrixImage& operator^=(const MatrixImage& image);
+  MatrixImage operator&(const MatrixImage& image) const;
+  MatrixImage operator|(const MatrixImage& image) const;
+  MatrixImage operator^(const MatrixImage& image) const;
+  MatrixImage operator~() const;
+
+  /**
+   * @brief Returns whether two images have all of the same pixels set.
+   */
+  bool operator==(const MatrixImage& image) const;
+  bool operator!=(const MatrixImage& image) const;
+
   /**
    * @brief Rotates this image in place in increments of 90 degrees.
    * 
@@ -224,30 +258,171 @@ public:  // public methods
    */
   void rotate_image(std::size_t rotation);
 
+  /**
+   * @brief Mirrors this image in place so that the left-most column becomes
+   *        the right-most column.
+   */
+  void flip_horizontal();
+
+  /**
+   * @brief Mirrors this image in place so that the top row becomes the bottom
+   *        row.
+   */
+  void flip_vertical();
+
+  /**
+   * @brief Function that transforms an 8x8 image stored as a 64-bit word.
+   */
+  using WordTransform = std::uint64_t (*)(std::uint64_t);
+
+  /**
+   * @brief Transposes an 8x8 image stored as a 64-bit word, i.e. mirrors it
+   *        across the diagonal that runs from row 0, column 0 to row 7,
+   *        column 7.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return transposed image data
+   */
+  static std::uint64_t transpose_word(std::uint64_t word);
+
+  /**
+   * @brief Mirrors an 8x8 image stored as a 64-bit word left to right.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return mirrored image data
+   */
+  static std::uint64_t flip_word_horizontal(std::uint64_t word);
+
+  /**
+   * @brief Mirrors an 8x8 image stored as a 64-bit word top to bottom.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return mirrored image data
+   */
+  static std::uint64_t flip_word_vertical(std::uint64_t word);
+
+  /**
+   * @brief Returns an 8x8 image stored as a 64-bit word unchanged.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return the same image data
+   */
+  static std::uint64_t rotate_word_0(std::uint64_t word);
+
+  /**
+   * @brief Rotates an 8x8 image stored as a 64-bit word 90 degrees clockwise.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return rotated image data
+   */
+  static std::uint64_t rotate_word_90(std::uint64_t word);
+
+  /**
+   * @brief Rotates an 8x8 image stored as a 64-bit word 180 degrees.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return rotated image data
+   */
+  static std::uint64_t rotate_word_180(std::uint64_t word);
+
+  /**
+   * @brief Rotates an 8x8 image stored as a 64-bit word 270 degrees
+   *        clockwise.
+   * 
+   * @param word image data laid out as described for `get_word()`
+   * @return rotated image data
+   */
+  static std::uint64_t rotate_word_270(std::uint64_t word);
+
+  /**
+   * @brief Rotates an 8x8 image stored as a 64-bit word by a number of 90
+   *        degree clockwise rotations that is fixed at compile time.
+   * 
+   * @tparam ROTATION number of 90 degree clockwise rotations
+   * @param word image data laid out as described for `get_word()`
+   * @return rotated image data
+   */
+  template <std::size_t ROTATION>
+  static std::uint64_t rotate_word(std::uint64_t word);
+
+  /**
+   * @brief Mirrors (if `MIRROR` is `true`) an 8x8 image stored as a 64-bit
+   *        word left to right and then rotates it, where both steps are fixed
+   *        at compile time.
+   * 
+   * Together with `rotate_word()`, these are all eight ways in which an 8x8
+   * image can be rotated and mirrored.
+   * 
+   * @tparam ROTATION number of 90 degree clockwise rotations
+   * @tparam MIRROR whether to mirror the image left to right first
+   * @param word image data laid out as described for `get_word()`
+   * @return transformed image data
+   */
+  template <std::size_t ROTATION, bool MIRROR>
+  static std::uint64_t transform_word(std::uint64_t word);
+
+  /**
+   * @brief Returns the word transform that rotates an image by the specified
+   *        number of 90 degree clockwise rotations.
+   * 
+   * @param rotation number of 90 degree clockwise rotations
+   * @return function that performs the rotation
+   */
+  static WordTransform get_rotation(std::size_t rotation);
+
+  /**
+   * @brief Returns the word transform that mirrors an image as specified and
+   *        then rotates it by the specified number of 90 degree clockwise
+   *        rotations.
+   * 
+   * @param rotation number of 90 degree clockwise rotations
+   * @param mirror_horizontal whether to mirror the image left to right
+   * @param mirror_vertical whether to mirror the image top to bottom
+   * @return function that performs the mirrors and the rotation
+   */
+  static WordTransform get_transform(std::size_t rotation,
+                                     bool mirror_horizontal,
+                                     bool mirror_vertical);
+
+private:  // private methods
+
+  /**
+   * @brief Returns the number of bits that a row is shifted by within
+   *        `image_data`.
+   * 
+   * @param row row of the image
+   * @return left-shift amount of the row's byte
+   */
+  static unsigned int row_shift(std::size_t row);
+
+  /**
+   * @brief Throws an exception if the specified pixel does not exist.
+   * 
+   * @param row row of the pixel
+   * @param col column of the pixel
+   */
+  static void check_bounds(std::size_t row, std::size_t col);
+
 };  // class MatrixImage
 
-inline MatrixImage::MatrixImage() : image_data{} { /* no body */ }
+inline MatrixImage::MatrixImage() : image_data{0} { /* no body */ }
 
-inline MatrixImage::MatrixImage(const MatrixImage& image_to_copy) {
-  // call the std::array copy assignment operator to copy array values 
-  image_data = image_to_copy.image_data;
-}
+inline MatrixImage::MatrixImage(std::uint64_t word)
+  : image_data{word} { /* no body */ }
 
 inline std::uint_fast8_t MatrixImage::left_shift_row(
     std::size_t row,
     std::uint_fast8_t fill_bit) {
-  
-  // store the msb which will be the return value
-  std::uint8_t msb{
-    static_cast<std::uint8_t>(image_data.at(row) >> (WIDTH - 1))};
 
-  // shift left one bit and fill in the rightmost bit with the fill bit
-  image_data.at(row) <<= 1;
-  image_data.at(row) |= fill_bit;
+  std::uint_fast8_t row_data{get_row(row)};
+
+  // store the msb which will be the return value
+  std::uint8_t msb{static_cast<std::uint8_t>(row_data >> (WIDTH - 1))};
 
-  // ensure only the least-significant 8 bits can be set for each row of
-  // data because the LED matrix only has 8 columns (pixels) per row
-  image_data.at(row) &= 0xFF;
+  // shift left one bit and fill in the rightmost bit with the fill bit; only
+  // the least-significant 8 bits are kept because the LED matrix only has 8
+  // columns (pixels) per row
+  set_row(row, ((row_data << 1) | fill_bit) & 0xFF);
 
   return msb;
 
@@ -256,23 +431,15 @@ inline std::uint_fast8_t MatrixImage::left_shift_row(
 inline void MatrixImage::set_pixel(std::size_t row, std::size_t col,
                                    std::uint_fast8_t value) {
 
-  // throw an exception if the column index provided is invalid
-  if (col >= WIDTH) {
-    throw std::out_of_range{
-      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
-      + "col index must be less than matrix width of " 
-      + std::to_string(WIDTH) + "; provided value was " 
-      + std::to_string(col)
-    };
-  }
+  check_bounds(row, col);
 
-  // set or unset the pixel depending on the boolean value of v; this can be
-  // accomplished without the if-else block, but I am assuming the compiler 
-  // will optimize that out
+  std::uint64_t mask{std::uint64_t{1} << row_shift(row) << (WIDTH - 1 - col)};
+
+  // set or unset the pixel depending on the boolean value of v
   if (value) {
-      image_data.at(row) |= 1 << (WIDTH - 1 - col);     
+    image_data |= mask;
   } else {
-      image_data.at(row) &= ~(1 << (WIDTH - 1 - col));
+    image_data &= ~mask;
   }
 
 }
@@ -280,6 +447,119 @@ inline void MatrixImage::set_pixel(std::size_t row, std::size_t col,
 inline std::uint_fast8_t MatrixImage::get_pixel(std::size_t row,
                                                 std::size_t col) const {
 
+  check_bounds(row, col);
+
+  // return boolean value (1 or 0) of the pixel in the specified location
+  return (image_data >> row_shift(row) >> (WIDTH - 1 - col)) & 1;
+
+}
+
+inline std::uint_fast8_t MatrixImage::get_row(std::size_t row) const {
+  check_bounds(row, 0);
+  return (image_data >> row_shift(row)) & 0xFF;
+}
+
+inline void MatrixImage::set_row(std::size_t row, std::uint_fast8_t value) {
+  check_bounds(row, 0);
+  image_data &= ~(std::uint64_t{0xFF} << row_shift(row));
+  image_data |= static_cast<std::uint64_t>(value & 0xFF) << row_shift(row);
+}
+
+inline std::uint64_t MatrixImage::get_word() const {
+  return image_data;
+}
+
+inline void MatrixImage::set_word(std::uint64_t word) {
+  image_data = word;
+}
+
+inline void MatrixImage::shift_left(std::size_t columns) {
+
+  // keep only the bits that stay within their own row
+  image_data = columns < WIDTH
+    ? (image_data << columns) & (ROW_LSB * ((0xFFu << columns) & 0xFF))
+    : 0;
+}
+
+inline void MatrixImage::shift_right(std::size_t columns) {
+
+  // keep only the bits that stay within their own row
+  image_data = columns < WIDTH
+    ? (image_data >> columns) & (ROW_LSB * (0xFFu >> columns))
+    : 0;
+}
+
+inline void MatrixImage::shift_up(std::size_t rows) {
+  image_data = rows < HEIGHT ? image_data << (WIDTH * rows) : 0;
+}
+
+inline void MatrixImage::shift_down(std::size_t rows) {
+  image_data = rows < HEIGHT ? image_data >> (WIDTH * rows) : 0;
+}
+
+inline std::size_t MatrixImage::count_pixels() const {
+  return static_cast<std::size_t>(__builtin_popcountll(image_data));
+}
+
+inline bool MatrixImage::is_blank() const {
+  return image_data == 0;
+}
+
+inline MatrixImage& MatrixImage::operator&=(const MatrixImage& image) {
+  image_data &= image.image_data;
+  return *this;
+}
+
+inline MatrixImage& MatrixImage::operator|=(const MatrixImage& image) {
+  image_data |= image.image_data;
+  return *this;
+}
+
+inline MatrixImage& MatrixImage::operator^=(const MatrixImage& image) {
+  image_data ^= image.image_data;
+  return *this;
+}
+
+inline MatrixImage MatrixImage::operator&(const MatrixImage& image) const {
+  return MatrixImage{image_data & image.image_data};
+}
+
+inline MatrixImage MatrixImage::operator|(const MatrixImage& image) const {
+  return MatrixImage{image_data | image.image_data};
+}
+
+inline MatrixImage MatrixImage::operator^(const MatrixImage& image) const {
+  return MatrixImage{image_data ^ image.image_data};
+}
+
+inline MatrixImage MatrixImage::operator~() const {
+  return MatrixImage{~image_data};
+}
+
+inline bool MatrixImage::operator==(const MatrixImage& image) const {
+  return image_data == image.image_data;
+}
+
+inline bool MatrixImage::operator!=(const MatrixImage& image) const {
+  return image_data != image.image_data;
+}
+
+inline unsigned int MatrixImage::row_shift(std::size_t row) {
+  return static_cast<unsigned int>(WIDTH * (HEIGHT - 1 - row));
+}
+
+inline void MatrixImage::check_bounds(std::size_t row, std::size_t col) {
+
+  // throw an exception if the row index provided is invalid
+  if (row >= HEIGHT) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "row index must be less than matrix height of "
+      + std::to_string(HEIGHT) + "; provided value was "
+      + std::to_string(row)
+    };
+  }
+
   // throw an exception if the column index provided is invalid
   if (col >= WIDTH) {
     throw std::out_of_range{
@@ -289,18 +569,127 @@ inline std::uint_fast8_t MatrixImage::get_pixel(std::size_t row,
       + std::to_string(col)
     };
   }
+}
 
-  // return boolean value (1 or 0) of the pixel in the specified location
-  return !!(image_data.at(row) & (1 << (WIDTH - 1 - col)));
+inline std::uint64_t MatrixImage::transpose_word(std::uint64_t word) {
+
+  // swap the bits across the diagonal in three steps: first bits within
+  // 2x2 blocks, then 2x2 blocks within 4x4 blocks, then 4x4 blocks
+  std::uint64_t t;
+  t = (word ^ (word >> 7)) & 0x00AA00AA00AA00AAULL;
+  word ^= t ^ (t << 7);
+  t = (word ^ (word >> 14)) & 0x0000CCCC0000CCCCULL;
+  word ^= t ^ (t << 14);
+  t = (word ^ (word >> 28)) & 0x00000000F0F0F0F0ULL;
+  word ^= t ^ (t << 28);
+  return word;
+}
 
+inline std::uint64_t MatrixImage::flip_word_horizontal(std::uint64_t word) {
+
+  // reverse the bits within every byte by swapping adjacent bits, then
+  // adjacent pairs of bits, then nibbles
+  word = ((word >> 1) & 0x5555555555555555ULL)
+    | ((word & 0x5555555555555555ULL) << 1);
+  word = ((word >> 2) & 0x3333333333333333ULL)
+    | ((word & 0x3333333333333333ULL) << 2);
+  word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL)
+    | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+  return word;
 }
 
-inline std::uint_fast8_t MatrixImage::get_row(std::size_t row) const {
-    return image_data.at(row);
+inline std::uint64_t MatrixImage::flip_word_vertical(std::uint64_t word) {
+  // reversing the order of the rows is reversing the order of the bytes
+  return __builtin_bswap64(word);
 }
 
-inline void MatrixImage::set_row(std::size_t row, std::uint_fast8_t value) {
-  image_data.at(row) = value;
+inline std::uint64_t MatrixImage::rotate_word_0(std::uint64_t word) {
+  return word;
+}
+
+inline std::uint64_t MatrixImage::rotate_word_90(std::uint64_t word) {
+  return flip_word_horizontal(transpose_word(word));
+}
+
+inline std::uint64_t MatrixImage::rotate_word_180(std::uint64_t word) {
+  return flip_word_horizontal(flip_word_vertical(word));
+}
+
+inline std::uint64_t MatrixImage::rotate_word_270(std::uint64_t word) {
+  return flip_word_vertical(transpose_word(word));
 }
 
+template <std::size_t ROTATION>
+inline std::uint64_t MatrixImage::rotate_word(std::uint64_t word) {
+
+  if constexpr (ROTATION % 4 == 1) {
+    return rotate_word_90(word);
+  } else if constexpr (ROTATION % 4 == 2) {
+    return rotate_word_180(word);
+  } else if constexpr (ROTATION % 4 == 3) {
+    return rotate_word_270(word);
+  } else {
+    return word;
+  }
+}
+
+template <std::size_t ROTATION, bool MIRROR>
+inline std::uint64_t MatrixImage::transform_word(std::uint64_t word) {
+
+  if constexpr (MIRROR) {
+    word = flip_word_horizontal(word);
+  }
+
+  return rotate_word<ROTATION>(word);
+}
+
+inline MatrixImage::WordTransform MatrixImage::get_rotation(
+    std::size_t rotation) {
+
+  static constexpr WordTransform rotations[]{
+    rotate_word_0, rotate_word_90, rotate_word_180, rotate_word_270,
+  };
+
+  return rotations[rotation % 4];
+}
+
+inline MatrixImage::WordTransform MatrixImage::get_transform(
+    std::size_t rotation, bool mirror_horizontal, bool mirror_vertical) {
+
+  static constexpr WordTransform transforms[2][4]{
+    {
+      transform_word<0, false>, transform_word<1, false>,
+      transform_word<2, false>, transform_word<3, false>,
+    },
+    {
+      transform_word<0, true>, transform_word<1, true>,
+      transform_word<2, true>, transform_word<3, true>,
+    },
+  };
+
+  // mirroring top to bottom is the same as mirroring left to right and
+  // rotating by 180 degrees
+  if (mirror_vertical) {
+    mirror_horizontal = !mirror_horizontal;
+    rotation += 2;
+  }
+
+  return transforms[mirror_horizontal ? 1 : 0][rotation % 4];
+}
+
+/**
+ * @brief Hashes a `MatrixImage` by its pixels so that images can be used as
+ *        keys of unordered containers.
+ */
+namespace std {
+
+template <>
+struct hash<MatrixImage> {
+  std::size_t operator()(const MatrixImage& image) const noexcept {
+    return std::hash<std::uint64_t>{}(image.get_word());
+  }
+};
+
+}  // namespace std
+
 #endif  // SCROLLER_MATRIX_IMAGE_H_
@@ -0,0 +1,101 @@
+/**
+ * @file MemoryTransport.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef MEMORY_TRANSPORT_H_
+#define MEMORY_TRANSPORT_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "SPITransport.h"
+
+/**
+ * @brief SPI transport that keeps all transactions in memory instead of
+ *        sending them to a device.
+ *
+ * Used to inspect and benchmark the data that a `MAX7219Chain` would send
+ * without requiring any SPI hardware.
+ */
+class MemoryTransport : public SPITransport {
+
+private:
+
+  /**
+   * Whether the contents of each transaction are stored; when `false`, only
+   * the statistics of the transport are updated.
+   */
+  bool recording;
+
+  /**
+   * Whether `init()` has been called without a subsequent `close()`.
+   */
+  bool initialized;
+
+  /**
+   * Copy of the data of each recorded chip-select transaction in the order
+   * in which they were made.
+   */
+  std::vector<std::vector<char>> transactions;
+
+public:
+
+  /**
+   * @brief Constructs an in-memory transport.
+   * 
+   * @param recording whether the contents of each transaction should be
+   *                  stored; disable to measure throughput without the cost
+   *                  of copying each transaction
+   */
+  MemoryTransport(bool recording = true);
+
+  int init() override;
+
+  int close() override;
+
+  /**
+   * @brief Returns whether the transport is currently initialized.
+   * 
+   * @return `true` if `init()` has been called without a later `close()`
+   */
+  bool is_initialized() const;
+
+  /**
+   * @brief Returns all recorded transactions.
+   * 
+   * @return recorded transactions in the order in which they were made
+   */
+  const std::vector<std::vector<char>>& get_transactions() const;
+
+  /**
+   * @brief Discards all recorded transactions.
+   */
+  void clear_transactions();
+
+protected:
+
+  void do_transfer(char* buffer, std::uint32_t buffer_length) override;
+
+};  // class MemoryTransport
+
+inline MemoryTransport::MemoryTransport(bool recording)
+  : recording{recording}
+  , initialized{false}
+  , transactions{} { /* no body */ }
+
+inline bool MemoryTransport::is_initialized() const {
+  return initialized;
+}
+
+inline const std::vector<std::vector<char>>&
+    MemoryTransport::get_transactions() const {
+  return transactions;
+}
+
+inline void MemoryTransport::clear_transactions() {
+  transactions.clear();
+}
+
+#endif  // MEMORY_TRANSPORT_H_
@@ -0,0 +1,250 @@
+/**
+ * @file SPITransport.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SPI_TRANSPORT_H_
+#define SPI_TRANSPORT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Abstract SPI bus used by a `MAX7219Chain` to send data to the
+ *        physical device.
+ *
+ * Each transaction is a single chip-select cycle: chip select is asserted,
+ * the buffer is shifted out, and chip select is released, which latches the
+ * shifted data into the MAX7219 chips. Transactions are either submitted one
+ * at a time with `transfer()` or several at a time with `transfer_batch()`,
+ * which backends may implement as a single call into the driver. Every
+ * submission is timed and counted so that the frame pipeline can be measured
+ * independently of the backend that is used.
+ */
+class SPITransport {
+
+public:
+
+  /**
+   * A single chip-select transaction within a batch.
+   */
+  struct Transaction {
+
+    /**
+     * Data to send; backends may overwrite it with received data.
+     */
+    char* buffer;
+
+    /**
+     * Number of bytes in the buffer.
+     */
+    std::uint32_t length;
+
+  };
+
+  /**
+   * Running totals for the transactions made through a transport.
+   */
+  struct Statistics {
+
+    /**
+     * Number of chip-select transactions made.
+     */
+    std::uint64_t transaction_count;
+
+    /**
+     * Number of submissions made to the backend; a batch counts as a single
+     * submission regardless of how many transactions it contains.
+     */
+    std::uint64_t submission_count;
+
+    /**
+     * Total number of bytes sent across all transactions.
+     */
+    std::uint64_t byte_count;
+
+    /**
+     * Total time spent inside of submissions.
+     */
+    std::chrono::nanoseconds total_time;
+
+    /**
+     * Time taken by the most recent submission.
+     */
+    std::chrono::nanoseconds last_time;
+
+    /**
+     * Time taken by the slowest submission.
+     */
+    std::chrono::nanoseconds max_time;
+
+  };
+
+private:
+
+  /**
+   * Statistics for all transactions made since construction or since the
+   * last call to `reset_statistics()`.
+   */
+  Statistics statistics;
+
+public:
+
+  /**
+   * Deletion of functions that could potentially be implicitly declared in
+   * order to prevent errors from accidental use.
+   */
+  SPITransport(const SPITransport&) = delete;
+  SPITransport(SPITransport&&) = delete;
+  SPITransport& operator=(const SPITransport&) = delete;
+  SPITransport& operator=(SPITransport&&) = delete;
+
+  /**
+   * @brief Constructs a transport with zeroed statistics.
+   */
+  SPITransport();
+
+  virtual ~SPITransport();
+
+  /**
+   * @brief Acquires and configures the SPI bus.
+   * 
+   * @return `1` if the bus was initialized successfully or `0` otherwise
+   */
+  virtual int init() = 0;
+
+  /**
+   * @brief Releases the SPI bus.
+   * 
+   * @return `1` if the bus was released successfully or `0` otherwise
+   */
+  virtual int close() = 0;
+
+  /**
+   * @brief Sends a buffer as a single chip-select transaction.
+   * 
+   * @param buffer data to send; backends may overwrite it with received data
+   * @param buffer_length number of bytes in the buffer
+   */
+  void transfer(char* buffer, std::uint32_t buffer_length);
+
+  /**
+   * @brief Sends several buffers, each as its own chip-select transaction,
+   *        in a single submission to the backend.
+   * 
+   * @param transactions array of transactions to send in order
+   * @param transaction_count number of transactions in the array
+   */
+  void transfer_batch(Transaction* transactions,
+                      std::size_t transaction_count);
+
+  /**
+   * @brief Returns the statistics for the transactions made so far.
+   * 
+   * @return transaction statistics for this transport
+   */
+  const Statistics& get_statistics() const;
+
+  /**
+   * @brief Sets all transaction statistics back to zero.
+   */
+  void reset_statistics();
+
+protected:
+
+  /**
+   * @brief Backend specific implementation of a single transaction.
+   * 
+   * @param buffer data to send
+   * @param buffer_length number of bytes in the buffer
+   */
+  virtual void do_transfer(char* buffer, std::uint32_t buffer_length) = 0;
+
+  /**
+   * @brief Backend specific implementation of a batch of transactions.
+   * 
+   * The default implementation makes one `do_transfer()` call for each
+   * transaction in the batch.
+   * 
+   * @param transactions array of transactions to send in order
+   * @param transaction_count number of transactions in the array
+   */
+  virtual void do_transfer_batch(Transaction* transactions,
+                                 std::size_t transaction_count);
+
+private:
+
+  /**
+   * @brief Adds a completed submission to the transport statistics.
+   * 
+   * @param transaction_count number of transactions in the submission
+   * @param byte_count number of bytes sent in the submission
+   * @param elapsed time taken by the submission
+   */
+  void record_submission(std::size_t transaction_count,
+                         std::uint64_t byte_count,
+                         std::chrono::nanoseconds elapsed);
+
+};  // class SPITransport
+
+inline SPITransport::SPITransport() : statistics{} { /* no body */ }
+
+inline SPITransport::~SPITransport() {}
+
+inline void SPITransport::transfer(char* buffer, std::uint32_t buffer_length) {
+
+  auto start = std::chrono::steady_clock::now();
+  do_transfer(buffer, buffer_length);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  record_submission(1, buffer_length, elapsed);
+}
+
+inline void SPITransport::transfer_batch(Transaction* transactions,
+                                         std::size_t transaction_count) {
+
+  auto start = std::chrono::steady_clock::now();
+  do_transfer_batch(transactions, transaction_count);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::uint64_t byte_count{0};
+  for (std::size_t i = 0; i < transaction_count; i++) {
+    byte_count += transactions[i].length;
+  }
+
+  record_submission(transaction_count, byte_count, elapsed);
+}
+
+inline void SPITransport::do_transfer_batch(Transaction* transactions,
+                                            std::size_t transaction_count) {
+
+  for (std::size_t i = 0; i < transaction_count; i++) {
+    do_transfer(transactions[i].buffer, transactions[i].length);
+  }
+}
+
+inline void SPITransport::record_submission(std::size_t transaction_count,
+                                            std::uint64_t byte_count,
+                                            std::chrono::nanoseconds elapsed) {
+
+  statistics.transaction_count += transaction_count;
+  statistics.submission_count++;
+  statistics.byte_count += byte_count;
+  statistics.last_time = elapsed;
+  statistics.total_time += elapsed;
+  if (elapsed > statistics.max_time) {
+    statistics.max_time = elapsed;
+  }
+}
+
+inline const SPITransport::Statistics& SPITransport::get_statistics() const {
+  return statistics;
+}
+
+inline void SPITransport::reset_statistics() {
+  statistics = Statistics{};
+}
+
+#endif  // SPI_TRANSPORT_H_
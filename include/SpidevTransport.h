@@ -0,0 +1,108 @@
+/**
+ * @file SpidevTransport.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SPIDEV_TRANSPORT_H_
+#define SPIDEV_TRANSPORT_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <linux/spi/spidev.h>
+
+#include "SPITransport.h"
+
+/**
+ * @brief SPI transport that uses the Linux `spidev` driver through a
+ *        `/dev/spidevX.Y` device node.
+ *
+ * A batch of transactions is submitted as a single `SPI_IOC_MESSAGE` ioctl
+ * with `cs_change` set between transfers so that chip select is released,
+ * and the data latched, after every transaction. Unlike the bcm2835 backend,
+ * this does not require root privileges or access to `/dev/mem`; only
+ * permission to open the device node.
+ *
+ * Every request to the driver goes through `control()`, so the transport can
+ * be exercised without SPI hardware by overriding it in a derived class and
+ * opening any readable and writable node, such as `/dev/null`, in place of
+ * the device.
+ */
+class SpidevTransport : public SPITransport {
+
+private:
+
+  /**
+   * Path of the spidev device node.
+   */
+  const std::string device_path;
+
+  /**
+   * SPI clock frequency in Hz.
+   */
+  const std::uint32_t speed_hz;
+
+  /**
+   * File descriptor of the open device node or `-1` if it is not open.
+   */
+  int file_descriptor;
+
+  /**
+   * Transfer descriptors reused between batches; sized for one frame (one
+   * transfer per matrix row) and only grows when a larger batch is submitted.
+   */
+  std::vector<spi_ioc_transfer> transfers;
+
+public:
+
+  /**
+   * @brief Constructs a transport for the specified spidev device node.
+   * 
+   * @param device_path path of the device node, e.g. `/dev/spidev0.0`
+   * @param speed_hz SPI clock frequency in Hz
+   */
+  SpidevTransport(std::string device_path = "/dev/spidev0.0",
+                  std::uint32_t speed_hz = 6'250'000);
+
+  /**
+   * @brief `SpidevTransport` destructor; closes the device node if it is
+   *        still open.
+   */
+  ~SpidevTransport();
+
+  /**
+   * @brief Opens the device node and configures it for the MAX7219 (mode 0,
+   *        MSB first, 8 bits per word); a device node that is already open
+   *        is closed first.
+   * 
+   * @return `1` if the device was opened and configured or `0` otherwise
+   */
+  int init() override;
+
+  /**
+   * @brief Closes the device node.
+   * 
+   * @return `1` if the device was closed successfully or `0` otherwise
+   */
+  int close() override;
+
+protected:
+
+  /**
+   * @brief Makes an ioctl request on the open device node.
+   * 
+   * @param request ioctl request number
+   * @param argument argument of the request
+   * @return result of the request; negative with `errno` set on failure
+   */
+  virtual int control(unsigned long request, void* argument);
+
+  void do_transfer(char* buffer, std::uint32_t buffer_length) override;
+
+  void do_transfer_batch(Transaction* transactions,
+                         std::size_t transaction_count) override;
+
+};  // class SpidevTransport
+
+#endif  // SPIDEV_TRANSPORT_H_
@@ -0,0 +1,166 @@
+/**
+ * @file TextFrameSource.h
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#ifndef SCROLLER_TEXT_FRAME_SOURCE_H_
+#define SCROLLER_TEXT_FRAME_SOURCE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "Font.h"
+#include "MatrixChainImage.h"
+#include "ChainImageView.h"
+#include "FrameSource.h"
+
+/**
+ * @brief A frame source that scrolls text across a display one column per
+ *        frame without drawing the whole text at once.
+ *
+ * Frame `n` shows the text as if it had been drawn onto one long image and
+ * a window the size of the display had been placed at column `n` of it.
+ * Only the glyphs under the window are drawn, into a strip two matrices
+ * longer than the display, so memory does not depend on the length of the
+ * text and the first frame is ready as soon as the source is constructed.
+ * The strip is redrawn only when the window moves past what has been drawn.
+ *
+ * ```
+ * TextFrameSource source{text, font, device_length};
+ * while (!source.is_finished()) {
+ *   device.display(source.get_frame());
+ *   source.next_frame();
+ * }
+ * ```
+ */
+class TextFrameSource : public FrameSource {
+
+private:
+
+  /**
+   * Text to scroll; it is not copied so that long texts are stored once.
+   */
+  const std::string& text;
+
+  /**
+   * Font used to draw the text.
+   */
+  Font& font;
+
+  /**
+   * Width of the display in pixels.
+   */
+  const std::size_t window_width;
+
+  /**
+   * Whether the text repeats endlessly instead of scrolling off the display.
+   */
+  const bool wrap;
+
+  /**
+   * Width in pixels of the whole text when drawn with `font`.
+   */
+  const std::size_t text_width;
+
+  /**
+   * Preallocated image onto which the glyphs under the window are drawn.
+   */
+  MatrixChainImage strip;
+
+  /**
+   * Index of the current frame, which is the column of the text at which the
+   * window starts.
+   */
+  std::size_t frame;
+
+  /**
+   * Index within the text of the first glyph drawn onto the strip.
+   */
+  std::size_t strip_glyph;
+
+  /**
+   * Column of the text at which the strip starts.
+   */
+  std::size_t strip_start;
+
+  /**
+   * Column of the text at which the drawn part of the strip ends; the strip
+   * shows the text correctly up to this column.
+   */
+  std::size_t strip_end;
+
+public:
+
+  /**
+   * @brief Constructs a frame source positioned at the first frame.
+   *
+   * @param text text to scroll; must outlive the frame source
+   * @param font font used to draw the text; must outlive the frame source
+   * @param length length of the display in 8x8 matrices
+   * @param wrap whether the text repeats endlessly instead of scrolling off
+   *             the display
+   */
+  TextFrameSource(const std::string& text, Font& font, std::size_t length,
+                  bool wrap = false);
+
+  /**
+   * Deletion of the constructor for temporary text, which would be destroyed
+   * while the frame source still refers to it.
+   */
+  TextFrameSource(std::string&& text, Font& font, std::size_t length,
+                  bool wrap = false) = delete;
+
+  void set_frame(std::size_t frame) override;
+
+  std::size_t get_frame_index() const override;
+
+  /**
+   * @brief Returns whether the window has moved past the end of the text;
+   *        never `true` for text that wraps.
+   *
+   * @return `true` if the window no longer shows any of the text
+   */
+  bool is_finished() const override;
+
+  /**
+   * @brief Draws the glyphs under the window if they have not been drawn
+   *        yet and returns a view of the window; does not allocate memory.
+   *
+   * @return view of the frame, valid until the next call
+   */
+  ChainImageView get_frame() override;
+
+private:
+
+  /**
+   * @brief Returns the width of the glyph of a character of the text.
+   *
+   * @param index index of the character within the text
+   * @return width of the glyph in pixels
+   */
+  std::size_t get_glyph_width(std::size_t index) const;
+
+  /**
+   * @brief Finds the glyph that covers the column at which the window
+   *        starts and draws it and the glyphs after it onto the strip.
+   *
+   * @param column column of the text at which the window starts
+   */
+  void draw_strip(std::size_t column);
+
+};  // class TextFrameSource
+
+inline std::size_t TextFrameSource::get_frame_index() const {
+  return frame;
+}
+
+inline bool TextFrameSource::is_finished() const {
+  return !wrap && frame >= text_width;
+}
+
+inline std::size_t TextFrameSource::get_glyph_width(std::size_t index) const {
+  return font.get_glyph_width(static_cast<std::uint_fast8_t>(text[index]));
+}
+
+#endif  // SCROLLER_TEXT_FRAME_SOURCE_H_
@@ -0,0 +1,33 @@
+/**
+ * @file BCM2835Transport.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <cstdint>
+
+#include "BCM2835Transport.h"
+#include "SPI.h"
+
+int BCM2835Transport::init() {
+
+  // attempt to initialize the library and SPI peripheral
+  int return_code = spi_init();
+  if (return_code == 0) {
+    return return_code;
+  }
+
+  // set SPI options
+  spi_set_options("", "", "", "");
+
+  return return_code;
+}
+
+int BCM2835Transport::close() {
+  return spi_close();
+}
+
+void BCM2835Transport::do_transfer(char* buffer,
+                                   std::uint32_t buffer_length) {
+  spi_send_data(buffer, buffer_length);
+}
@@ -6,37 +6,146 @@
 
 #include <string>
 #include <array>
-#include <fstream>
 #include <memory>
 #include <cstdint>
+#include <algorithm>
+#include <stdexcept>
 
 #include "Font.h"
 #include "Glyph.h"
 
 Font::Font(std::string font_file_name, bool proportional,
-           std::size_t spacing) {
+           std::size_t spacing)
+  : Font{FontFile{font_file_name}, proportional, spacing} { /* no body */ }
 
-  // open the font file to read its contents
-  std::ifstream font_file(font_file_name, std::ios::binary);
+const std::array<Font::BlankGlyphMetrics, 2> Font::RAW_BLANK_GLYPH_METRICS{{
+  {0x20, 4, 0},
+  {0xFF, 1, Glyph::FIXED_ADVANCE},
+}};
 
-  // make sure the font file was opened
-  if (font_file.is_open()) {
+Font::Font(const FontFile& font_file, bool proportional, std::size_t spacing)
+  : font_glyphs{}
+  , shifted_glyphs{}
+  , proportional{proportional}
+  , spacing{spacing} {
 
-    // for each character in the font
-    for (std::size_t code_point = 0;
-         code_point < FONT_CHAR_COUNT; code_point++) {
+  load_glyphs(font_file);
+  build_shifted_glyphs();
+}
 
-      // read the data for the current character into an array
-      std::array<uint8_t, Glyph::HEIGHT> new_glyph_data;
-      font_file.read(
-        reinterpret_cast<char*>(new_glyph_data.data()),
-        Glyph::HEIGHT
-      );
+Font::Font(const std::uint8_t (&font_data)[FONT_DATA_SIZE], bool proportional,
+           std::size_t spacing)
+  : font_glyphs{}
+  , shifted_glyphs{}
+  , proportional{proportional}
+  , spacing{spacing} {
 
-      // create a new glyph object with the data ready from the font file
-      font_glyphs.at(code_point) = new Glyph(
-        new_glyph_data, proportional, code_point, spacing);
+  load_glyphs(font_data);
+  build_shifted_glyphs();
+}
 
+void Font::load_glyphs(const std::uint8_t* font_data) {
+
+  // for each character in the font
+  for (std::size_t code_point = 0;
+       code_point < FONT_CHAR_COUNT; code_point++) {
+
+    // copy the data for the current character into an array
+    std::array<std::uint8_t, Glyph::HEIGHT> new_glyph_data;
+    std::copy(font_data + code_point * Glyph::HEIGHT,
+              font_data + (code_point + 1) * Glyph::HEIGHT,
+              new_glyph_data.begin());
+
+    // create a glyph whose metrics are computed from its data
+    font_glyphs[code_point] = Glyph{new_glyph_data};
+
+  }
+
+  // give the blank glyphs that are not zero width their metrics
+  for (const BlankGlyphMetrics& metrics : RAW_BLANK_GLYPH_METRICS) {
+    Glyph& glyph = font_glyphs[metrics.code_point];
+    if (glyph.get_advance() == 0) {
+      std::array<std::uint8_t, Glyph::HEIGHT> glyph_data{};
+      glyph = Glyph{glyph_data, 0, metrics.advance, metrics.flags};
+    }
+  }
+}
+
+void Font::load_glyphs(const FontFile& font_file) {
+
+  // a raw font has no metrics, so they are computed from the glyph data
+  if (font_file.is_raw()) {
+    load_glyphs(font_file.get_glyph_rows(0));
+    return;
+  }
+
+  // code points beyond the glyph count of the container are left blank
+  for (std::size_t code_point = 0;
+       code_point < font_file.get_glyph_count(); code_point++) {
+
+    // copy the data for the current character out of the mapping
+    const std::uint8_t* rows = font_file.get_glyph_rows(code_point);
+    std::array<std::uint8_t, Glyph::HEIGHT> new_glyph_data;
+    std::copy(rows, rows + Glyph::HEIGHT, new_glyph_data.begin());
+
+    // create a glyph with the precomputed metrics from the container
+    font_glyphs[code_point] = Glyph{
+      new_glyph_data,
+      static_cast<std::uint_fast8_t>(font_file.get_left_bearing(code_point)),
+      static_cast<std::uint_fast8_t>(font_file.get_advance(code_point)),
+      font_file.get_flags(code_point)};
+
+  }
+
+  // a version 1 container stores no flags, so its blank glyphs are given the
+  // metrics of the blank glyphs of raw fonts; the advances it stores for
+  // them are the same
+  if (!font_file.has_flags()) {
+    for (const BlankGlyphMetrics& metrics : RAW_BLANK_GLYPH_METRICS) {
+      if (metrics.code_point >= font_file.get_glyph_count()) {
+        continue;
+      }
+      const std::uint8_t* rows = font_file.get_glyph_rows(metrics.code_point);
+      if (std::all_of(rows, rows + Glyph::HEIGHT,
+                      [](std::uint8_t row) { return row == 0; })) {
+        std::array<std::uint8_t, Glyph::HEIGHT> glyph_data{};
+        font_glyphs[metrics.code_point] =
+          Glyph{glyph_data, 0, metrics.advance, metrics.flags};
+      }
+    }
+  }
+}
+
+void Font::build_shifted_glyphs() {
+
+  for (std::size_t code_point = 0; code_point < FONT_CHAR_COUNT;
+       code_point++) {
+
+    const Glyph& glyph = font_glyphs[code_point];
+
+    // columns covered by the glyph when it starts at column 0 of a 16-bit
+    // value that spans two matrices
+    std::uint_fast16_t width_mask{static_cast<std::uint_fast16_t>(
+      (0xFF00 << (Glyph::WIDTH_MAX - glyph.get_width(proportional, spacing)))
+      & 0xFF00)};
+
+    for (std::size_t offset = 0; offset < BIT_OFFSET_COUNT; offset++) {
+
+      ShiftedGlyph& shifted = shifted_glyphs[code_point][offset];
+
+      // split the shifted mask and rows between the two matrices
+      std::uint_fast16_t mask{
+        static_cast<std::uint_fast16_t>(width_mask >> offset)};
+      shifted.first_mask = static_cast<std::uint8_t>(mask >> 8);
+      shifted.second_mask = static_cast<std::uint8_t>(mask);
+
+      for (std::size_t row = 0; row < Glyph::HEIGHT; row++) {
+        std::uint_fast16_t row_data{static_cast<std::uint_fast16_t>(
+          ((glyph.get_drawn_row(row, proportional) << 8) & width_mask)
+          >> offset)};
+        shifted.first_rows[row] = static_cast<std::uint8_t>(row_data >> 8);
+        shifted.second_rows[row] = static_cast<std::uint8_t>(row_data);
+      }
     }
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,152 @@
+/**
+ * @file FontFile.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FontFile.h"
+#include "Glyph.h"
+
+constexpr char FontFile::MAGIC[];
+
+FontFile::FontFile(const std::string& path)
+  : path{path}
+  , data{nullptr}
+  , size{0}
+  , raw{false}
+  , glyph_count{0}
+  , advances{nullptr}
+  , left_bearings{nullptr}
+  , glyph_flags{nullptr}
+  , glyph_rows{nullptr} {
+
+  int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) {
+    fail(__LINE__, std::string{"could not open font file: "}
+                   + std::strerror(errno));
+  }
+
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0) {
+    int error{errno};
+    close(fd);
+    fail(__LINE__, std::string{"could not read font file size: "}
+                   + std::strerror(error));
+  }
+
+  size = static_cast<std::size_t>(file_status.st_size);
+  if (size == 0) {
+    close(fd);
+    fail(__LINE__, "font file is empty");
+  }
+
+  // the mapping stays valid after the file descriptor is closed
+  void* mapping{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+  int error{errno};
+  close(fd);
+
+  if (mapping == MAP_FAILED) {
+    size = 0;
+    fail(__LINE__, std::string{"could not map font file: "}
+                   + std::strerror(error));
+  }
+
+  data = static_cast<const std::uint8_t*>(mapping);
+
+  if (size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0) {
+    parse_container();
+  } else if (size == RAW_SIZE) {
+    raw = true;
+    glyph_count = MAX_GLYPH_COUNT;
+    glyph_rows = data;
+  } else {
+    fail(__LINE__, "font file is neither a " + std::to_string(RAW_SIZE)
+                   + " byte raw font nor a font container");
+  }
+}
+
+FontFile::~FontFile() {
+  if (data != nullptr) {
+    munmap(const_cast<std::uint8_t*>(data), size);
+  }
+}
+
+void FontFile::parse_container() {
+
+  if (size < HEADER_SIZE) {
+    fail(__LINE__, "font container header is truncated");
+  }
+
+  std::uint16_t version{
+    static_cast<std::uint16_t>(data[4] | (data[5] << 8))};
+  if (version != VERSION && version != UNFLAGGED_VERSION) {
+    fail(__LINE__, "font container version " + std::to_string(version)
+                   + " is not supported; expected version "
+                   + std::to_string(UNFLAGGED_VERSION) + " or "
+                   + std::to_string(VERSION));
+  }
+
+  glyph_count = static_cast<std::size_t>(data[6] | (data[7] << 8));
+  if (glyph_count == 0 || glyph_count > MAX_GLYPH_COUNT) {
+    fail(__LINE__, "font container glyph count must be from 1 to "
+                   + std::to_string(MAX_GLYPH_COUNT) + "; value was "
+                   + std::to_string(glyph_count));
+  }
+
+  if (data[8] != GLYPH_HEIGHT) {
+    fail(__LINE__, "font container glyph height must be "
+                   + std::to_string(GLYPH_HEIGHT) + "; value was "
+                   + std::to_string(data[8]));
+  }
+
+  // a version 1 container has no table of flags
+  std::size_t table_count{version == UNFLAGGED_VERSION ? 2u : 3u};
+  std::size_t expected_size{
+    HEADER_SIZE + table_count * glyph_count + GLYPH_HEIGHT * glyph_count};
+  if (size != expected_size) {
+    fail(__LINE__, "font container with " + std::to_string(glyph_count)
+                   + " glyphs must be " + std::to_string(expected_size)
+                   + " bytes; file is " + std::to_string(size) + " bytes");
+  }
+
+  advances = data + HEADER_SIZE;
+  left_bearings = advances + glyph_count;
+  glyph_flags = version == UNFLAGGED_VERSION ? nullptr
+                                             : left_bearings + glyph_count;
+  glyph_rows = left_bearings + (table_count - 1) * glyph_count;
+
+  // metrics must describe columns within the glyph, and only known flags may
+  // be set
+  for (std::size_t code_point = 0; code_point < glyph_count; code_point++) {
+    if (left_bearings[code_point] >= GLYPH_WIDTH
+        || left_bearings[code_point] + advances[code_point] > GLYPH_WIDTH
+        || (get_flags(code_point) & ~Glyph::FIXED_ADVANCE) != 0) {
+      fail(__LINE__, "font container metrics for glyph "
+                     + std::to_string(code_point) + " are out of range");
+    }
+  }
+}
+
+void FontFile::fail(int line, const std::string& message) {
+
+  if (data != nullptr) {
+    munmap(const_cast<std::uint8_t*>(data), size);
+    data = nullptr;
+  }
+
+  throw std::runtime_error{
+    std::string{__FILE__} + ":" + std::to_string(line) + "\t"
+    + path + ": " + message
+  };
+}
@@ -0,0 +1,247 @@
+/**
+ * @file FrameDecoder.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+#include "FrameDecoder.h"
+
+FrameDecoder::FrameDecoder(const FrameFile& file)
+  : file{file}
+  , rows(file.get_frame_size())
+  , next_frame{0}
+  , next_record{file.frames}
+  , changed_rows{0} { /* no body */ }
+
+void FrameDecoder::seek(std::size_t frame) {
+
+  // throw an exception if the frame index provided is invalid
+  if (frame >= file.get_frame_count()) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame index must be less than frame count of "
+      + std::to_string(file.get_frame_count()) + "; provided value was "
+      + std::to_string(frame)
+    };
+  }
+
+  changed_rows = 0;
+
+  // frames can only be decoded forward, so moving backward starts over; the
+  // rows displayed before are then unknown, and so is the very first frame
+  bool starting_over{next_frame == 0 || frame + 1 < next_frame};
+  if (starting_over) {
+    rewind();
+  }
+
+  while (next_frame <= frame) {
+    decode_next();
+  }
+
+  if (starting_over) {
+    changed_rows = ALL_ROWS;
+  }
+}
+
+void FrameDecoder::shift_frame(std::uint8_t* rows, std::size_t length,
+                               std::size_t matrix_orientation, int shift,
+                               const std::uint8_t* incoming) {
+
+  // rotated matrices show the columns of the image as their rows, and
+  // matrices turned upside down show them in the opposite order
+  bool reversed{matrix_orientation % 4 >= 2};
+  if (matrix_orientation % 2 == 1) {
+    shift_columns(rows, length, shift, incoming, reversed);
+    return;
+  }
+
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    shift_row(rows + row * length, length, shift, incoming[row], reversed);
+  }
+}
+
+void FrameDecoder::get_incoming_columns(const std::uint8_t* rows,
+                                        std::size_t length,
+                                        std::size_t matrix_orientation,
+                                        int shift, std::uint8_t* incoming) {
+
+  bool reversed{matrix_orientation % 4 >= 2};
+  std::size_t count{static_cast<std::size_t>(shift > 0 ? shift : -shift)};
+  std::fill(incoming, incoming + MatrixImage::HEIGHT, 0);
+
+  // the columns shifted in are the last columns after a positive shift and
+  // the first columns after a negative shift
+  if (matrix_orientation % 2 == 1) {
+    std::size_t first{shift > 0 ? MatrixImage::HEIGHT * length - count : 0};
+    for (std::size_t i = 0; i < count; i++) {
+      incoming[i] = rows[get_column_index(first + i, length, reversed)];
+    }
+    return;
+  }
+
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    const std::uint8_t* row_data = rows + row * length;
+    incoming[row] = shift > 0 ? row_data[length - 1] : row_data[0];
+  }
+}
+
+void FrameDecoder::shift_row(std::uint8_t* row, std::size_t length,
+                             int shift, std::uint8_t incoming,
+                             bool reversed) {
+
+  // bits move toward the first byte when the shift is positive, which is
+  // toward the most-significant bit unless the columns are reversed
+  unsigned int bits{static_cast<unsigned int>(shift > 0 ? shift : -shift)};
+  bool shift_up{(shift > 0) != reversed};
+  std::uint8_t incoming_mask{static_cast<std::uint8_t>(
+    shift_up ? (1u << bits) - 1 : 0xFF & ~(0xFF >> bits))};
+
+  auto shift_byte = [bits, shift_up](unsigned int value,
+                                     unsigned int neighbor) {
+    return static_cast<std::uint8_t>(shift_up
+      ? (value << bits) | (neighbor >> (8 - bits))
+      : (value >> bits) | (neighbor << (8 - bits)));
+  };
+
+  if (shift > 0) {
+
+    // each byte takes its new bits from the byte after it
+    for (std::size_t i = 0; i + 1 < length; i++) {
+      row[i] = shift_byte(row[i], row[i + 1]);
+    }
+    row[length - 1] = shift_byte(row[length - 1], 0)
+                      | (incoming & incoming_mask);
+
+  } else if (shift < 0) {
+
+    // each byte takes its new bits from the byte before it
+    for (std::size_t i = length - 1; i > 0; i--) {
+      row[i] = shift_byte(row[i], row[i - 1]);
+    }
+    row[0] = shift_byte(row[0], 0) | (incoming & incoming_mask);
+
+  }
+}
+
+void FrameDecoder::shift_columns(std::uint8_t* rows, std::size_t length,
+                                 int shift, const std::uint8_t* incoming,
+                                 bool reversed) {
+
+  std::size_t column_count{MatrixImage::HEIGHT * length};
+
+  if (shift > 0) {
+
+    std::size_t count{static_cast<std::size_t>(shift)};
+    for (std::size_t k = 0; k + count < column_count; k++) {
+      rows[get_column_index(k, length, reversed)]
+        = rows[get_column_index(k + count, length, reversed)];
+    }
+    for (std::size_t i = 0; i < count; i++) {
+      rows[get_column_index(column_count - count + i, length, reversed)]
+        = incoming[i];
+    }
+
+  } else if (shift < 0) {
+
+    std::size_t count{static_cast<std::size_t>(-shift)};
+    for (std::size_t k = column_count; k-- > count;) {
+      rows[get_column_index(k, length, reversed)]
+        = rows[get_column_index(k - count, length, reversed)];
+    }
+    for (std::size_t i = 0; i < count; i++) {
+      rows[get_column_index(i, length, reversed)] = incoming[i];
+    }
+
+  }
+}
+
+std::size_t FrameDecoder::get_column_index(std::size_t column,
+                                           std::size_t length,
+                                           bool reversed) {
+
+  std::size_t row{column % MatrixImage::HEIGHT};
+  if (reversed) {
+    row = MatrixImage::HEIGHT - 1 - row;
+  }
+
+  return row * length + column / MatrixImage::HEIGHT;
+}
+
+void FrameDecoder::rewind() {
+  std::fill(rows.begin(), rows.end(), 0);
+  next_frame = 0;
+  next_record = file.frames;
+}
+
+void FrameDecoder::decode_next() {
+
+  std::size_t length{file.get_length()};
+
+  // every frame of a raw file is stored in full
+  if (!file.is_encoded()) {
+    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+      replace_row(row, next_record + row * length);
+    }
+    next_record += file.get_frame_size();
+    next_frame++;
+    return;
+  }
+
+  // records were validated when the file was opened
+  FrameFile::Encoding encoding{
+    static_cast<FrameFile::Encoding>(next_record[0])};
+  const std::uint8_t* payload = next_record + 1;
+  std::uint8_t row_mask{0};
+
+  switch (encoding) {
+
+    case FrameFile::Encoding::KEYFRAME:
+      for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+        replace_row(row, payload + row * length);
+      }
+      break;
+
+    case FrameFile::Encoding::DELTA: {
+      row_mask = payload[0];
+      const std::uint8_t* row_data = payload + 1;
+      for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+        if (row_mask & (1 << row)) {
+          replace_row(row, row_data);
+          row_data += length;
+        }
+      }
+      break;
+    }
+
+    case FrameFile::Encoding::REPEAT:
+      break;
+
+    case FrameFile::Encoding::SHIFT:
+      shift_frame(rows.data(), length, file.get_matrix_orientation(),
+                  static_cast<std::int8_t>(payload[0]), payload + 1);
+      // a shift changes every row that is not blank before and after it
+      changed_rows = ALL_ROWS;
+      break;
+
+  }
+
+  next_record += 1 + FrameFile::get_payload_size(encoding, length, row_mask);
+  next_frame++;
+}
+
+void FrameDecoder::replace_row(std::size_t row, const std::uint8_t* data) {
+
+  std::size_t length{file.get_length()};
+  std::uint8_t* row_data = rows.data() + row * length;
+
+  if (!std::equal(data, data + length, row_data)) {
+    std::copy(data, data + length, row_data);
+    changed_rows |= static_cast<std::uint8_t>(1 << row);
+  }
+}
@@ -0,0 +1,229 @@
+/**
+ * @file FrameFile.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FrameFile.h"
+
+constexpr char FrameFile::MAGIC[];
+
+FrameFile::FrameFile(const std::string& path)
+  : path{path}
+  , data{nullptr}
+  , size{0}
+  , version{0}
+  , length{0}
+  , matrix_orientation{0}
+  , upside_down{false}
+  , transform_table_id{0}
+  , frame_count{0}
+  , frame_period{0}
+  , frames{nullptr} {
+
+  int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) {
+    fail(__LINE__, std::string{"could not open frame file: "}
+                   + std::strerror(errno));
+  }
+
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0) {
+    int error{errno};
+    close(fd);
+    fail(__LINE__, std::string{"could not read frame file size: "}
+                   + std::strerror(error));
+  }
+
+  size = static_cast<std::size_t>(file_status.st_size);
+  if (size < HEADER_SIZE) {
+    close(fd);
+    fail(__LINE__, "frame file header is truncated");
+  }
+
+  // the mapping stays valid after the file descriptor is closed
+  void* mapping{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+  int error{errno};
+  close(fd);
+
+  if (mapping == MAP_FAILED) {
+    size = 0;
+    fail(__LINE__, std::string{"could not map frame file: "}
+                   + std::strerror(error));
+  }
+
+  data = static_cast<const std::uint8_t*>(mapping);
+
+  // frames are played from first to last, so the kernel can read ahead of
+  // playback and drop pages once they have been played; the advice is only a
+  // hint, so playback works even if it is not taken
+  madvise(mapping, size, MADV_SEQUENTIAL);
+
+  parse_header();
+}
+
+FrameFile::~FrameFile() {
+  if (data != nullptr) {
+    munmap(const_cast<std::uint8_t*>(data), size);
+  }
+}
+
+void FrameFile::parse_header() {
+
+  if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+    fail(__LINE__, "file is not a frame file");
+  }
+
+  version = static_cast<std::uint16_t>(read_value(4, 2));
+  if (version != VERSION && version != RAW_VERSION) {
+    fail(__LINE__, "frame file version " + std::to_string(version)
+                   + " is not supported; expected version "
+                   + std::to_string(RAW_VERSION) + " or "
+                   + std::to_string(VERSION));
+  }
+
+  matrix_orientation = read_value(6, 1);
+  if (matrix_orientation > 3) {
+    fail(__LINE__, "frame file matrix orientation must be from 0 to 3; "
+                   "value was " + std::to_string(matrix_orientation));
+  }
+
+  std::uint64_t flags{read_value(7, 1)};
+  if ((flags & ~static_cast<std::uint64_t>(UPSIDE_DOWN | TRANSFORM_TABLE))
+      != 0) {
+    fail(__LINE__, "frame file has unknown flags set");
+  }
+  upside_down = flags & UPSIDE_DOWN;
+
+  length = read_value(8, 4);
+  if (length == 0) {
+    fail(__LINE__, "frame file chain length must not be 0");
+  }
+
+  frame_count = read_value(12, 4);
+  frame_period = std::chrono::nanoseconds{read_value(16, 8)};
+  if (frame_period.count() <= 0) {
+    fail(__LINE__, "frame file frame period must be greater than 0");
+  }
+
+  // the module transform table of the chain follows the header if the chain
+  // has one
+  std::size_t frames_offset{HEADER_SIZE};
+  if (flags & TRANSFORM_TABLE) {
+    if (size < HEADER_SIZE + TRANSFORM_TABLE_SIZE) {
+      fail(__LINE__, "frame file module transform table is truncated");
+    }
+    transform_table_id = read_value(HEADER_SIZE, TRANSFORM_TABLE_SIZE);
+    if (transform_table_id == 0) {
+      fail(__LINE__, "frame file module transform table must not be 0");
+    }
+    frames_offset += TRANSFORM_TABLE_SIZE;
+  }
+
+  frames = data + frames_offset;
+
+  if (is_encoded()) {
+    validate_records();
+    return;
+  }
+
+  // the frames must fill the rest of the file exactly; dividing rather than
+  // multiplying keeps a corrupt frame count from overflowing
+  std::size_t frame_bytes{size - frames_offset};
+  if (frame_bytes % get_frame_size() != 0
+      || frame_bytes / get_frame_size() != frame_count) {
+    fail(__LINE__, "frame file with " + std::to_string(frame_count)
+                   + " frames of " + std::to_string(get_frame_size())
+                   + " bytes must be " + std::to_string(
+                       frames_offset + frame_count * get_frame_size())
+                   + " bytes; file is " + std::to_string(size) + " bytes");
+  }
+}
+
+void FrameFile::validate_records() {
+
+  std::size_t offset{static_cast<std::size_t>(frames - data)};
+
+  for (std::size_t frame = 0; frame < frame_count; frame++) {
+
+    if (offset >= size) {
+      fail(__LINE__, "frame file ends after " + std::to_string(frame)
+                     + " of " + std::to_string(frame_count) + " frames");
+    }
+
+    std::uint8_t encoding_value{data[offset]};
+    if (encoding_value > static_cast<std::uint8_t>(Encoding::SHIFT)) {
+      fail(__LINE__, "frame " + std::to_string(frame)
+                     + " has unknown encoding "
+                     + std::to_string(encoding_value));
+    }
+    Encoding encoding{static_cast<Encoding>(encoding_value)};
+
+    // the row mask of a delta frame is needed to know its size, and the
+    // shift of a shift frame must be within a byte
+    std::uint8_t row_mask{0};
+    if (encoding == Encoding::DELTA || encoding == Encoding::SHIFT) {
+      if (offset + 1 >= size) {
+        fail(__LINE__, "frame " + std::to_string(frame) + " is truncated");
+      }
+      row_mask = data[offset + 1];
+    }
+
+    if (encoding == Encoding::SHIFT) {
+      int shift{static_cast<std::int8_t>(data[offset + 1])};
+      if (shift == 0 || shift > static_cast<int>(MAX_SHIFT)
+          || -shift > static_cast<int>(MAX_SHIFT)) {
+        fail(__LINE__, "frame " + std::to_string(frame) + " shift of "
+                       + std::to_string(shift) + " is out of range");
+      }
+    }
+
+    std::size_t record_size{1 + get_payload_size(encoding, length, row_mask)};
+    if (record_size > size - offset) {
+      fail(__LINE__, "frame " + std::to_string(frame) + " is truncated");
+    }
+
+    offset += record_size;
+  }
+
+  if (offset != size) {
+    fail(__LINE__, "frame file has " + std::to_string(size - offset)
+                   + " bytes after its last frame");
+  }
+}
+
+std::uint64_t FrameFile::read_value(std::size_t offset,
+                                    std::size_t byte_count) const {
+
+  std::uint64_t value{0};
+  for (std::size_t i = byte_count; i--;) {
+    value = (value << 8) | data[offset + i];
+  }
+
+  return value;
+}
+
+void FrameFile::fail(int line, const std::string& message) {
+
+  if (data != nullptr) {
+    munmap(const_cast<std::uint8_t*>(data), size);
+    data = nullptr;
+  }
+
+  throw std::runtime_error{
+    std::string{__FILE__} + ":" + std::to_string(line) + "\t"
+    + path + ": " + message
+  };
+}
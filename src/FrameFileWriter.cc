@@ -0,0 +1,209 @@
+/**
+ * @file FrameFileWriter.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "FrameFileWriter.h"
+#include "FrameFile.h"
+#include "FrameDecoder.h"
+
+FrameFileWriter::FrameFileWriter(const std::string& path,
+                                 const MAX7219Chain& device,
+                                 std::chrono::nanoseconds frame_period)
+  : path{path}
+  , device{device}
+  , file{}
+  , frame{device.get_length(), 1}
+  , previous_rows(frame.get_frame_size())
+  , record(2 + frame.get_frame_size())
+  , shifted_rows(frame.get_frame_size())
+  , frame_count{0} {
+
+  // throw an exception if the frame period provided is invalid
+  if (frame_period.count() <= 0) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame period must be greater than 0; provided value was "
+      + std::to_string(frame_period.count()) + " ns"
+    };
+  }
+
+  file.open(path, std::ios::binary | std::ios::trunc);
+  check_file(__LINE__, "could not create frame file");
+
+  // the frame count is written as 0 and filled in when the file is closed
+  file.write(FrameFile::MAGIC, sizeof(FrameFile::MAGIC));
+  write_value(FrameFile::VERSION, 2);
+  std::uint64_t transform_table_id{device.get_transform_table_id()};
+  write_value(device.get_matrix_orientation() % 4, 1);
+  write_value((device.is_upside_down() ? FrameFile::UPSIDE_DOWN : 0)
+              | (transform_table_id != 0 ? FrameFile::TRANSFORM_TABLE : 0),
+              1);
+  write_value(device.get_length(), 4);
+  write_value(0, 4);
+  write_value(static_cast<std::uint64_t>(frame_period.count()), 8);
+  if (transform_table_id != 0) {
+    write_value(transform_table_id, FrameFile::TRANSFORM_TABLE_SIZE);
+  }
+  check_file(__LINE__, "could not write frame file header");
+}
+
+FrameFileWriter::~FrameFileWriter() {
+  try {
+    close();
+  } catch (const std::exception&) {
+    // errors can only be reported by calling close() directly
+  }
+}
+
+void FrameFileWriter::write_frame(const ChainImageView& view) {
+
+  // the frame count is stored in 4 bytes
+  if (frame_count == 0xFFFFFFFF) {
+    throw std::runtime_error{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + path + ": a frame file holds at most " + std::to_string(frame_count)
+      + " frames"
+    };
+  }
+
+  // the frame store keeps its capacity, so rendering does not allocate
+  frame.clear();
+  device.record_frame(view, frame);
+
+  // the record is written before the frame replaces the previous frame, so
+  // the frame is encoded against the previous frame again if writing fails
+  const std::uint8_t* rows = frame.get_frame(0);
+  encode_frame(rows);
+
+  std::size_t record_size{1 + FrameFile::get_payload_size(
+    static_cast<FrameFile::Encoding>(record[0]), frame.get_length(),
+    record[1])};
+  file.write(reinterpret_cast<const char*>(record.data()),
+             static_cast<std::streamsize>(record_size));
+  check_file(__LINE__, "could not write frame " + std::to_string(frame_count));
+
+  std::copy(rows, rows + frame.get_frame_size(), previous_rows.begin());
+  frame_count++;
+}
+
+void FrameFileWriter::close() {
+
+  if (!file.is_open()) {
+    return;
+  }
+
+  // fill in the frame count that was left as 0 in the header
+  file.seekp(12);
+  write_value(frame_count, 4);
+  file.close();
+  check_file(__LINE__, "could not complete frame file");
+}
+
+void FrameFileWriter::encode_frame(const std::uint8_t* rows) {
+
+  std::size_t length{frame.get_length()};
+
+  // find the rows that differ from the frame before
+  std::uint8_t row_mask{0};
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    const std::uint8_t* row_data = rows + row * length;
+    if (!std::equal(row_data, row_data + length,
+                    previous_rows.begin() + row * length)) {
+      row_mask |= static_cast<std::uint8_t>(1 << row);
+    }
+  }
+
+  if (row_mask == 0) {
+    record[0] = static_cast<std::uint8_t>(FrameFile::Encoding::REPEAT);
+    return;
+  }
+
+  std::size_t keyframe_size{FrameFile::get_payload_size(
+    FrameFile::Encoding::KEYFRAME, length)};
+  std::size_t delta_size{FrameFile::get_payload_size(
+    FrameFile::Encoding::DELTA, length, row_mask)};
+  std::size_t shift_size{FrameFile::get_payload_size(
+    FrameFile::Encoding::SHIFT, length)};
+
+  // scrolling moves every row by the same number of columns, which is
+  // cheaper to describe than the rows themselves once the chain is long
+  // enough; smaller shifts are tried first since they are the most common
+  if (shift_size < std::min(keyframe_size, delta_size)) {
+    for (int shift = 1; shift <= static_cast<int>(FrameFile::MAX_SHIFT);
+         shift++) {
+      if (encode_shift(rows, shift) || encode_shift(rows, -shift)) {
+        return;
+      }
+    }
+  }
+
+  if (delta_size < keyframe_size) {
+    record[0] = static_cast<std::uint8_t>(FrameFile::Encoding::DELTA);
+    record[1] = row_mask;
+    std::uint8_t* row_data = record.data() + 2;
+    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+      if (row_mask & (1 << row)) {
+        row_data = std::copy(rows + row * length, rows + (row + 1) * length,
+                             row_data);
+      }
+    }
+    return;
+  }
+
+  record[0] = static_cast<std::uint8_t>(FrameFile::Encoding::KEYFRAME);
+  std::copy(rows, rows + frame.get_frame_size(), record.begin() + 1);
+}
+
+bool FrameFileWriter::encode_shift(const std::uint8_t* rows, int shift) {
+
+  std::size_t length{frame.get_length()};
+  std::size_t orientation{device.get_matrix_orientation() % 4};
+  std::uint8_t* incoming = record.data() + 2;
+
+  // shift the frame before exactly as the decoder would and check that it
+  // matches the frame being written
+  FrameDecoder::get_incoming_columns(rows, length, orientation, shift,
+                                     incoming);
+  std::copy(previous_rows.begin(), previous_rows.end(), shifted_rows.begin());
+  FrameDecoder::shift_frame(shifted_rows.data(), length, orientation, shift,
+                            incoming);
+  if (!std::equal(shifted_rows.begin(), shifted_rows.end(), rows)) {
+    return false;
+  }
+
+  record[0] = static_cast<std::uint8_t>(FrameFile::Encoding::SHIFT);
+  record[1] = static_cast<std::uint8_t>(static_cast<std::int8_t>(shift));
+  return true;
+}
+
+void FrameFileWriter::write_value(std::uint64_t value,
+                                  std::size_t byte_count) {
+
+  for (std::size_t i = 0; i < byte_count; i++) {
+    file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void FrameFileWriter::check_file(int line, const std::string& message) {
+
+  if (!file) {
+    int error{errno};
+    file.close();
+    throw std::runtime_error{
+      std::string{__FILE__} + ":" + std::to_string(line) + "\t"
+      + path + ": " + message + ": " + std::strerror(error)
+    };
+  }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file FramePipeline.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <cstdint>
+#include <exception>
+#include <thread>
+
+#include "FramePipeline.h"
+#include "ChainImageView.h"
+
+FramePipeline::FramePipeline(MAX7219Chain& device, FrameSource& source,
+                             std::size_t capacity)
+  : device{device}
+  , source{source}
+  , rendered_frames{capacity, [&device] {
+      return MatrixChainImage{device.get_length()};
+    }}
+  , serialized_frames{capacity, [&device] {
+      return FrameStore{device.get_length(), 1};
+    }} { /* no body */ }
+
+std::uint64_t FramePipeline::run(std::uint64_t frame_count) {
+  return run_stages(frame_count, nullptr);
+}
+
+std::uint64_t FramePipeline::run(FrameScheduler& scheduler,
+                                 std::uint64_t frame_count) {
+  scheduler.restart();
+  return run_stages(frame_count, &scheduler);
+}
+
+std::uint64_t FramePipeline::run_stages(std::uint64_t frame_count,
+                                        FrameScheduler* scheduler) {
+
+  rendered_frames.reset();
+  serialized_frames.reset();
+
+  // a stage that fails stops the others, and each stage closes the ring
+  // after it so that the next stage finishes once the ring is empty
+  std::exception_ptr render_error;
+  std::thread render_thread{[this, frame_count, &render_error] {
+    try {
+      render_frames(frame_count);
+    } catch (...) {
+      render_error = std::current_exception();
+      stop();
+    }
+    rendered_frames.close();
+  }};
+
+  // if the second thread cannot be started, the first must be stopped and
+  // joined before the exception leaves, or destroying it would terminate
+  std::exception_ptr serialize_error;
+  std::thread serialize_thread;
+  try {
+    serialize_thread = std::thread{[this, &serialize_error] {
+      try {
+        serialize_frames();
+      } catch (...) {
+        serialize_error = std::current_exception();
+        stop();
+      }
+      serialized_frames.close();
+    }};
+  } catch (...) {
+    stop();
+    render_thread.join();
+    throw;
+  }
+
+  std::uint64_t sent_count{0};
+  std::exception_ptr transmit_error;
+  try {
+    sent_count = transmit_frames(scheduler);
+  } catch (...) {
+    transmit_error = std::current_exception();
+    stop();
+  }
+
+  render_thread.join();
+  serialize_thread.join();
+
+  // report the error of the earliest stage, since it is likely to have
+  // caused the others
+  for (const std::exception_ptr& error :
+       {render_error, serialize_error, transmit_error}) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return sent_count;
+}
+
+void FramePipeline::render_frames(std::uint64_t frame_count) {
+
+  for (std::uint64_t frame = 0;
+       (frame_count == 0 || frame < frame_count) && !source.is_finished();
+       frame++) {
+
+    MatrixChainImage* image = rendered_frames.wait_for_write_slot();
+    if (image == nullptr) {
+      return;
+    }
+
+    // the view only stays valid until the source moves on, so the frame is
+    // copied into the slot
+    source.get_frame().copy_to(*image);
+
+    rendered_frames.publish();
+    source.next_frame();
+  }
+}
+
+void FramePipeline::serialize_frames() {
+
+  while (MatrixChainImage* image = rendered_frames.wait_for_read_slot()) {
+
+    FrameStore* rows = serialized_frames.wait_for_write_slot();
+    if (rows == nullptr) {
+      return;
+    }
+
+    // the store keeps its capacity, so recording the frame does not allocate
+    rows->clear();
+    device.record_frame(ChainImageView{*image}, *rows);
+
+    rendered_frames.release();
+    serialized_frames.publish();
+  }
+}
+
+std::uint64_t FramePipeline::transmit_frames(FrameScheduler* scheduler) {
+
+  std::uint64_t sent_count{0};
+
+  // index of the frame at the front of the ring, and of the frame that the
+  // scheduler will return next
+  std::uint64_t frame{0};
+  std::uint64_t next_due_frame{0};
+  std::uint64_t due_frame{0};
+
+  while (FrameStore* rows = serialized_frames.wait_for_read_slot()) {
+
+    // wait for the deadline of the frame unless it has already passed; a
+    // scheduler that skips late frames can name a later frame instead
+    if (scheduler != nullptr && frame >= next_due_frame) {
+      due_frame = scheduler->wait_for_next_frame();
+      next_due_frame = due_frame + 1;
+    }
+
+    // frames that the scheduler skipped are dropped without being sent
+    if (scheduler == nullptr || frame == due_frame) {
+      device.display(*rows, 0);
+      sent_count++;
+    }
+
+    serialized_frames.release();
+    frame++;
+  }
+
+  return sent_count;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file FramePlayer.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <cstdint>
+
+#include "FramePlayer.h"
+
+FramePlayer::FramePlayer(MAX7219Chain& device, const FrameFile& file,
+                         FrameScheduler::MissedDeadlinePolicy policy)
+  : device{device}
+  , file{file}
+  , decoder{file}
+  , scheduler{file.get_frame_period(), policy} { /* no body */ }
+
+void FramePlayer::play(std::uint64_t loop_count) {
+
+  std::uint64_t frame_count{file.get_frame_count()};
+  if (frame_count == 0) {
+    return;
+  }
+
+  // frame indices from the scheduler keep counting across loops, so the
+  // last frame is shown for a full period before playback ends
+  scheduler.restart();
+  for (std::uint64_t frame = scheduler.wait_for_next_frame();
+       loop_count == 0 || frame < loop_count * frame_count;
+       frame = scheduler.wait_for_next_frame()) {
+
+    // the decoder starts over when playback loops back to the first frame
+    decoder.seek(frame % frame_count);
+    if (decoder.get_changed_rows() != 0) {
+      device.display(decoder);
+    }
+  }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file FrameScheduler.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cerrno>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <time.h>
+
+#include "FrameScheduler.h"
+
+FrameScheduler::FrameScheduler(double frames_per_second,
+                               MissedDeadlinePolicy policy)
+  : FrameScheduler{to_frame_period(frames_per_second), policy} {
+  /* no body */
+}
+
+FrameScheduler::FrameScheduler(std::chrono::nanoseconds frame_period,
+                               MissedDeadlinePolicy policy)
+  : frame_period{frame_period}
+  , policy{policy}
+  , started{false}
+  , start_time{0}
+  , next_frame{0}
+  , statistics{} {
+
+  // throw an exception if the frame period provided is invalid; deadlines
+  // are found by dividing by it
+  if (frame_period.count() <= 0) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame period must be greater than 0; provided value was "
+      + std::to_string(frame_period.count()) + " ns"
+    };
+  }
+}
+
+std::uint64_t FrameScheduler::wait_for_next_frame() {
+
+  // the first frame starts the timeline and is due immediately
+  if (!started) {
+    started = true;
+    start_time = now();
+    next_frame = 0;
+  }
+
+  std::chrono::nanoseconds deadline{start_time + next_frame * frame_period};
+  std::chrono::nanoseconds current_time{now()};
+
+  if (current_time < deadline) {
+
+    // sleep until the absolute deadline so that oversleeping or time spent
+    // on the previous frame does not shift later deadlines
+    sleep_until(deadline);
+    current_time = now();
+
+  } else if (current_time - deadline >= frame_period) {
+
+    // at least one more deadline has passed since this frame was due
+    statistics.missed_deadline_count++;
+
+    if (policy == MissedDeadlinePolicy::SKIP) {
+
+      // jump to the most recent frame that is due
+      std::uint64_t due_frame = (current_time - start_time) / frame_period;
+      statistics.skipped_frame_count += due_frame - next_frame;
+      next_frame = due_frame;
+      deadline = start_time + next_frame * frame_period;
+    }
+  }
+
+  record_frame(current_time - deadline);
+
+  return next_frame++;
+}
+
+std::chrono::nanoseconds FrameScheduler::to_frame_period(
+    double frames_per_second) {
+
+  // throw an exception if the frame rate provided is invalid or its period
+  // cannot be represented; casting it would be undefined
+  double period{1'000'000'000.0 / frames_per_second};
+  if (!std::isfinite(frames_per_second) || frames_per_second <= 0.0
+      || period >= static_cast<double>(
+                     std::numeric_limits<std::int64_t>::max())) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame rate must be finite and greater than 0, with a period that "
+      + "fits in 64-bit nanoseconds; provided value was "
+      + std::to_string(frames_per_second)
+    };
+  }
+
+  return std::chrono::nanoseconds{static_cast<std::int64_t>(period)};
+}
+
+std::chrono::nanoseconds FrameScheduler::now() {
+
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+
+  return std::chrono::seconds{time.tv_sec}
+    + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+void FrameScheduler::sleep_until(std::chrono::nanoseconds deadline) {
+
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(deadline);
+
+  timespec time;
+  time.tv_sec = seconds.count();
+  time.tv_nsec = (deadline - seconds).count();
+
+  // an absolute sleep can simply be restarted if it is interrupted by a signal
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr)
+         == EINTR) {}
+}
+
+void FrameScheduler::record_frame(std::chrono::nanoseconds jitter) {
+
+  if (statistics.frame_count == 0 || jitter < statistics.min_jitter) {
+    statistics.min_jitter = jitter;
+  }
+  if (statistics.frame_count == 0 || jitter > statistics.max_jitter) {
+    statistics.max_jitter = jitter;
+  }
+
+  statistics.frame_count++;
+  statistics.last_jitter = jitter;
+  statistics.total_jitter += jitter;
+}
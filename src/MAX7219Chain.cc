@@ -4,60 +4,254 @@
  * @version 0.1.0
  */
 
+#include <array>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
 #include "MAX7219Chain.h"
 #include "MatrixChainImage.h"
-#include "SPI.h"
+#include "BCM2835Transport.h"
 
 MAX7219Chain::MAX7219Chain(std::size_t length, std::size_t matrix_orientation,
-                           bool upside_down, char intensity)
-  : length{length}
+                           bool upside_down, char intensity, bool warm_start)
+  : MAX7219Chain(std::make_unique<BCM2835Transport>(), nullptr, length,
+                 matrix_orientation, upside_down,
+                 compile_transform_plan(length, matrix_orientation,
+                                        upside_down),
+                 select_render_kernel(matrix_orientation, upside_down),
+                 intensity, warm_start) { /* no body */ }
+
+MAX7219Chain::MAX7219Chain(SPITransport& transport, std::size_t length,
+                           std::size_t matrix_orientation, bool upside_down,
+                           char intensity, bool warm_start)
+  : MAX7219Chain(nullptr, &transport, length, matrix_orientation,
+                 upside_down,
+                 compile_transform_plan(length, matrix_orientation,
+                                        upside_down),
+                 select_render_kernel(matrix_orientation, upside_down),
+                 intensity, warm_start) { /* no body */ }
+
+MAX7219Chain::MAX7219Chain(
+    const std::vector<ModuleTransform>& module_transforms, char intensity,
+    bool warm_start)
+  : MAX7219Chain(std::make_unique<BCM2835Transport>(), nullptr,
+                 module_transforms.size(), 0, false,
+                 compile_transform_plan(module_transforms),
+                 &MAX7219Chain::render_planned,
+                 intensity, warm_start) { /* no body */ }
+
+MAX7219Chain::MAX7219Chain(
+    SPITransport& transport,
+    const std::vector<ModuleTransform>& module_transforms, char intensity,
+    bool warm_start)
+  : MAX7219Chain(nullptr, &transport, module_transforms.size(), 0, false,
+                 compile_transform_plan(module_transforms),
+                 &MAX7219Chain::render_planned,
+                 intensity, warm_start) { /* no body */ }
+
+MAX7219Chain::MAX7219Chain(std::unique_ptr<SPITransport> owned_transport,
+                           SPITransport* shared_transport,
+                           std::size_t length, std::size_t matrix_orientation,
+                           bool upside_down,
+                           std::vector<ModulePlan> transform_plan,
+                           RenderKernel render_kernel, char intensity,
+                           bool warm_start)
+  : owned_transport{std::move(owned_transport)}
+  , transport{shared_transport != nullptr ? *shared_transport
+                                          : *this->owned_transport}
+  , length{length}
   , matrix_orientation{matrix_orientation}
   , upside_down{upside_down}
-  , intensity{intensity} {
+  , transform_plan{std::move(transform_plan)}
+  , transform_table_id{render_kernel == &MAX7219Chain::render_planned
+                       ? hash_transform_plan(this->transform_plan) : 0}
+  , render_kernel{render_kernel}
+  , intensity{intensity}
+  , command_buffer(MatrixImage::HEIGHT * 2 * length)
+  , row_transactions{}
+  , startup_sequence{}
+  , shutdown_sequence{}
+  , latched_rows(MatrixImage::HEIGHT * length)
+  , latched_rows_valid{false}
+  , delta_transmission{true}
+  , front_rows(MatrixImage::HEIGHT * length)
+  , back_rows(MatrixImage::HEIGHT * length)
+  , preprocess_rows(MatrixImage::HEIGHT * length)
+  , frame_pending{false}
+  , dropped_frame_count{0}
+  , async_mode{false}
+  , stop_requested{false}
+  , transmit_error{} {
+
+  initialize(warm_start);
+}
 
-  // TODO - add return code checking
-  // initalize the SPI library functionality
-  spi_init();
+void MAX7219Chain::initialize(bool warm_start) {
 
-  // set SPI options
-  spi_set_options("", "", "", "");
+  // each row of the frame is sent as its own transaction from its own section
+  // of the command buffer
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    row_transactions.at(row) = {
+      command_buffer.data() + row * 2 * length,
+      static_cast<std::uint32_t>(2 * length)
+    };
+  }
 
-  // shutdown all of the LED matrices
-  hide();
+  // a device that is already running keeps showing its content until the
+  // first frame is displayed; otherwise it is shut down while it is set up
+  if (!warm_start) {
+    append_command_all(
+      startup_sequence,
+      MAX7219Register::SHUTDOWN,
+      static_cast<char>(ShutdownMode::DEVICE_OFF)
+    );
+  }
 
   // set test mode to 'not testing' mode
-  send_command_all(
+  append_command_all(
+    startup_sequence,
     MAX7219Register::TEST,
     static_cast<char>(TestMode::TEST_OFF)
   );
 
   // set scan limit to 'display all digits (rows)'
-  send_command_all(
+  append_command_all(
+    startup_sequence,
     MAX7219Register::SCAN_LIMIT,
     static_cast<char>(ScanLimit::SHOW_ALL_DIGITS)
   );
 
   // set decode mode to 'no decoding'
-  send_command_all(
+  append_command_all(
+    startup_sequence,
     MAX7219Register::DECODE_MODE,
     static_cast<char>(DecodeMode::NO_DECODE)
   );
 
   // set intensity to the specified value
-  set_intensity(intensity);
+  append_command_all(startup_sequence, MAX7219Register::INTENSITY, intensity);
 
   // send a blank image to all of the LED matrices
-  clear();
+  if (!warm_start) {
+    for (std::size_t r = 0; r < MatrixImage::HEIGHT; r++) {
+      append_command_all(startup_sequence, row_index_to_row_register(r), 0x00);
+    }
+  }
 
   // turn low-power mode off which enables the device display
-  show();
+  append_command_all(
+    startup_sequence,
+    MAX7219Register::SHUTDOWN,
+    static_cast<char>(ShutdownMode::DEVICE_ON)
+  );
+
+  finalize_sequence(startup_sequence);
+
+  // the shutdown sequence is built now so that the destructor does not need
+  // to allocate; it blanks the LED matrices and then shuts them down
+  for (std::size_t r = 0; r < MatrixImage::HEIGHT; r++) {
+    append_command_all(shutdown_sequence, row_index_to_row_register(r), 0x00);
+  }
+
+  append_command_all(
+    shutdown_sequence,
+    MAX7219Register::SHUTDOWN,
+    static_cast<char>(ShutdownMode::DEVICE_OFF)
+  );
+
+  finalize_sequence(shutdown_sequence);
+
+  // initalize and configure the SPI bus; nothing can be sent to the device
+  // if this fails
+  if (transport.init() == 0) {
+    throw std::runtime_error{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "failed to initialize the SPI transport"
+    };
+  }
+
+  // configure the device in a single batch; the destructor does not run if
+  // this throws, so the transport is closed here
+  try {
+    send_sequence(startup_sequence);
+  } catch (...) {
+    transport.close();
+    throw;
+  }
+
+  // after a cold start the device is known to be blank; after a warm start
+  // its content is unknown, so the first frame is sent in full
+  std::fill(latched_rows.begin(), latched_rows.end(), 0x00);
+  latched_rows_valid = !warm_start;
 
 }
 
 MAX7219Chain::~MAX7219Chain() {
-  clear();
-  hide();
-  spi_close();
+
+  // errors cannot be reported from a destructor, and the device is still
+  // shut down if the transmit thread failed
+  try {
+    stop_async();
+  } catch (const std::exception&) {
+    // errors can only be reported by calling stop_async() directly
+  }
+
+  // blank and shut down the device in a single batch; the transport is
+  // closed even if the device cannot be reached
+  try {
+    send_sequence(shutdown_sequence);
+  } catch (const std::exception&) {
+    // errors cannot be reported from a destructor
+  }
+  transport.close();
+}
+
+void MAX7219Chain::append_command_all(CommandSequence& sequence,
+                                      MAX7219Register device_register,
+                                      char data) const {
+  append_command_all(sequence, static_cast<char>(device_register), data);
+}
+
+void MAX7219Chain::append_command_all(CommandSequence& sequence,
+                                      char register_value, char data) const {
+
+  // add a command string with the same command repeated for each chip
+  for (std::size_t i = 0; i < length; i++) {
+    sequence.commands.push_back(register_value);
+    sequence.commands.push_back(data);
+  }
+}
+
+void MAX7219Chain::finalize_sequence(CommandSequence& sequence) const {
+
+  // transactions can only point into the command strings once no more
+  // commands will be added, since adding commands may move the strings
+  std::size_t transaction_length{2 * length};
+  sequence.transactions.clear();
+
+  for (std::size_t offset = 0; offset < sequence.commands.size();
+       offset += transaction_length) {
+
+    sequence.transactions.push_back({
+      sequence.commands.data() + offset,
+      static_cast<std::uint32_t>(transaction_length)
+    });
+  }
+}
+
+void MAX7219Chain::send_sequence(CommandSequence& sequence) {
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
+  transport.transfer_batch(sequence.transactions.data(),
+                           sequence.transactions.size());
 }
 
 void MAX7219Chain::send_command_all(MAX7219Register device_register, char data) {
@@ -66,30 +260,27 @@ void MAX7219Chain::send_command_all(MAX7219Register device_register, char data)
 
 void MAX7219Chain::send_command_all(char register_value, char data) {
 
-  // create a new vector large enough to hold an element for the register and
-  // and element for the data for each MAX7219 chip in the chain
-  std::vector<char>* command_string = new std::vector<char>(length * 2);
+  // use the command string of the first row in the command buffer, which is
+  // large enough to hold a register and data element for each chip
+  char* command_string = row_transactions.at(0).buffer;
 
   for (size_t i = 0; i < length; i++) {
 
-    // fill the command string vector with the same command repeated
-    command_string->at(2 * i) = register_value;
-    command_string->at(2 * i + 1) = data;
+    // fill the command string with the same command repeated
+    command_string[2 * i] = register_value;
+    command_string[2 * i + 1] = data;
 
   }
 
-  // send command to device and free memory allocated for the command vector
-  send_command_string(command_string);
-
-}
+  // send command to device
+  transport.transfer(command_string, row_transactions.at(0).length);
 
-void MAX7219Chain::send_command_string(std::vector<char>* command_string) {
-  spi_send_data(command_string->data(), command_string->size());
-  delete command_string;
 }
 
 void MAX7219Chain::clear() {
 
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
+
   // iterate over the indices of each row in the matrix
   for (size_t r = 0; r < MatrixImage::HEIGHT; r++) {
 
@@ -97,9 +288,29 @@ void MAX7219Chain::clear() {
     send_command_all(row_index_to_row_register(r), 0x00);
 
   }
+
+  // the device is now known to be blank
+  std::fill(latched_rows.begin(), latched_rows.end(), 0x00);
+  latched_rows_valid = true;
+}
+
+void MAX7219Chain::set_delta_transmission(bool enabled) {
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
+  delta_transmission = enabled;
+}
+
+void MAX7219Chain::force_full_refresh() {
+
+  {
+    std::lock_guard<std::mutex> bus_lock{bus_mutex};
+    latched_rows_valid = false;
+  }
+
+  report_transmit_error();
 }
 
 void MAX7219Chain::show() {
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
   send_command_all(
     MAX7219Register::SHUTDOWN,
     static_cast<char>(ShutdownMode::DEVICE_ON)
@@ -107,6 +318,7 @@ void MAX7219Chain::show() {
 }
 
 void MAX7219Chain::hide() {
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
   send_command_all(
     MAX7219Register::SHUTDOWN,
     static_cast<char>(ShutdownMode::DEVICE_OFF)
@@ -114,6 +326,7 @@ void MAX7219Chain::hide() {
 }
 
 void MAX7219Chain::set_intensity(char intensity) {
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
   send_command_all(MAX7219Register::INTENSITY, intensity);
   this->intensity = intensity;
 }
@@ -130,115 +343,552 @@ char MAX7219Chain::row_index_to_row_register(std::size_t index) {
   return static_cast<char>(index + 1);
 }
 
-void MAX7219Chain::display_raw(MatrixChainImage& image) {
+void MAX7219Chain::display_raw(const MatrixChainImage& image) {
+
+  // the image is already laid out as the device expects it
+  ChainImageView view{image};
+  send_frame([this, &view](std::uint8_t* rows) {
+    render_rows<0, false>(view, rows);
+  });
+}
+
+template <typename Fill>
+void MAX7219Chain::send_frame(Fill fill) {
+
+  if (async_mode) {
+
+    report_transmit_error();
+
+    {
+      std::lock_guard<std::mutex> frame_lock{frame_mutex};
 
-  std::vector<char>* command_string{nullptr};
+      // a frame that has not been picked up by the transmit thread yet is
+      // replaced so that the latest frame is always the one displayed
+      if (frame_pending) {
+        dropped_frame_count++;
+      }
+
+      fill(back_rows.data());
+      frame_pending = true;
+    }
+
+    frame_ready.notify_one();
+
+  } else {
+
+    std::lock_guard<std::mutex> bus_lock{bus_mutex};
+    fill(front_rows.data());
+    transmit_rows(front_rows.data());
+
+  }
+}
+
+void MAX7219Chain::transmit_rows(const std::uint8_t* rows) {
+
+  // transactions for only the rows that need to be sent
+  std::array<SPITransport::Transaction, MatrixImage::HEIGHT> transactions;
+  std::size_t transaction_count{0};
+
+  // rows are compared against the latched data only if it is trustworthy
+  bool send_deltas{delta_transmission && latched_rows_valid};
 
   // image must be displayed one row at a time
   for (std::size_t r = 0; r < MatrixImage::HEIGHT; r++) {
 
-    // create a vector of appropriate length to hold the command string
-    command_string = new std::vector<char>(length * 2);
+    char* command_string = row_transactions.at(r).buffer;
+    const std::uint8_t* row = rows + r * length;
+    std::uint8_t* latched_row = latched_rows.data() + r * length;
+    bool row_changed{false};
 
     // iterate over the matricies that make up the image
     for (std::size_t m = 0; m < length; m++) {
 
-      // fill the command string with row register followed by image data
-      // for each matrix in the image
-      command_string->at(2 * m) = row_index_to_row_register(r);
-      command_string->at(2 * m + 1) = image.get_row_of_matrix(m, r);
+      if (send_deltas && row[m] == latched_row[m]) {
+
+        // the chip already displays this row; since every chip in the chain
+        // receives a command in each transaction, send it a no-op
+        command_string[2 * m] = static_cast<char>(MAX7219Register::NO_OP);
+        command_string[2 * m + 1] = 0x00;
 
+      } else {
+
+        // fill the command string with row register followed by image data
+        command_string[2 * m] = row_index_to_row_register(r);
+        command_string[2 * m + 1] = static_cast<char>(row[m]);
+        latched_row[m] = row[m];
+        row_changed = true;
+
+      }
+    }
+
+    // rows that are unchanged on every chip are not sent at all
+    if (row_changed) {
+      transactions.at(transaction_count++) = row_transactions.at(r);
+    }
+  }
+
+  latched_rows_valid = true;
+
+  // send all of the changed rows to the device in a single batch; if that
+  // fails, the device may hold any mix of old and new rows
+  if (transaction_count != 0) {
+    try {
+      transport.transfer_batch(transactions.data(), transaction_count);
+    } catch (...) {
+      latched_rows_valid = false;
+      throw;
     }
+  }
+}
+
+void MAX7219Chain::start_async() {
+
+  if (async_mode) {
+    return;
+  }
+
+  stop_requested = false;
+  frame_pending = false;
+  async_mode = true;
+  transmit_thread = std::thread{&MAX7219Chain::transmit_loop, this};
+}
+
+void MAX7219Chain::stop_async() {
+
+  if (!async_mode) {
+    return;
+  }
 
-    // sends command to the device and frees command string memory
-    send_command_string(command_string);
+  {
+    std::lock_guard<std::mutex> frame_lock{frame_mutex};
+    stop_requested = true;
+  }
+
+  frame_ready.notify_one();
+  transmit_thread.join();
+  async_mode = false;
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> frame_lock{frame_mutex};
+    std::swap(error, transmit_error);
+  }
 
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool MAX7219Chain::is_async() const {
+  return async_mode;
+}
+
+std::uint64_t MAX7219Chain::get_dropped_frame_count() const {
+  std::lock_guard<std::mutex> frame_lock{frame_mutex};
+  return dropped_frame_count;
+}
+
+void MAX7219Chain::transmit_loop() {
+
+  while (true) {
+
+    {
+      std::unique_lock<std::mutex> frame_lock{frame_mutex};
+
+      frame_ready.wait(frame_lock, [this] {
+        return frame_pending || stop_requested;
+      });
+
+      // the last published frame is still sent before the thread exits
+      if (!frame_pending) {
+        return;
+      }
+
+      // take the published frame; the render thread can now publish the next
+      // frame into the other buffer while this one is being sent
+      std::swap(front_rows, back_rows);
+      frame_pending = false;
+    }
+
+    // an exception must not leave the thread, so it is kept to be thrown by
+    // the thread that publishes frames, and the thread stops
+    try {
+      std::lock_guard<std::mutex> bus_lock{bus_mutex};
+      transmit_rows(front_rows.data());
+    } catch (...) {
+      std::lock_guard<std::mutex> frame_lock{frame_mutex};
+      transmit_error = std::current_exception();
+      return;
+    }
+  }
+}
+
+void MAX7219Chain::report_transmit_error() {
+
+  if (!async_mode) {
+    return;
+  }
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> frame_lock{frame_mutex};
+    std::swap(error, transmit_error);
+  }
+
+  // the transmit thread has already exited, so frames are sent synchronously
+  // from now on
+  if (error) {
+    transmit_thread.join();
+    async_mode = false;
+    std::rethrow_exception(error);
   }
 }
 
 void MAX7219Chain::preprocess(MatrixChainImage& image) {
 
-  // rotate entire blocks of the supplied image where blocks correspond with
-  // physical circuit boards containing multiple 8x8 matrices
-  image.rotate_image(static_cast<std::size_t>(upside_down));
+  // frames that are displayed are oriented by the render kernels, so this
+  // only serves images that are turned into command vectors and is not
+  // specialized for the orientation
+  if (transform_table_id == 0) {
+
+    // rotate entire blocks of the supplied image where blocks correspond
+    // with physical circuit boards containing multiple 8x8 matrices
+    image.rotate_image(static_cast<std::size_t>(upside_down));
 
-  // rotate the 8x8 `MatrixImage`s that make up the `MatrixChainImage` by
-  // the amount needed for the image to display properly on this device
-  image.rotate_matrices(matrix_orientation);
+    // rotate the 8x8 `MatrixImage`s that make up the `MatrixChainImage` by
+    // the amount needed for the image to display properly on this device
+    image.rotate_matrices(matrix_orientation);
+    return;
+  }
+
+  // matrices can move to other positions, so the transformed matrices are
+  // rendered into a separate buffer and then copied back into the image
+  render_planned(ChainImageView{image}, preprocess_rows.data());
 
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    for (std::size_t matrix = 0; matrix < length; matrix++) {
+      image.set_row_of_matrix(matrix, row,
+                              preprocess_rows[row * length + matrix]);
+    }
+  }
+}
+
+template <std::size_t ROTATION, bool UPSIDE_DOWN>
+void MAX7219Chain::render_rows(const ChainImageView& view,
+                               std::uint8_t* rows) const {
+
+  // rotating the whole chain by 180 degrees reverses the order of the
+  // matrices and rotates each of them by 180 degrees, which combines with the
+  // rotation of each matrix into a single rotation
+  constexpr std::size_t rotation{UPSIDE_DOWN ? ROTATION + 2 : ROTATION};
+
+  for (std::size_t first = 0; first < length; first += 8) {
+
+    // read the next eight matrices of the window, one matrix per word
+    std::uint64_t words[MatrixImage::HEIGHT];
+    view.get_matrix_words(first * MatrixImage::WIDTH, words);
+
+    std::size_t count{std::min<std::size_t>(8, length - first)};
+    for (std::size_t i = 0; i < count; i++) {
+      store_matrix_rows(
+        MatrixImage::rotate_word<rotation>(words[i]),
+        UPSIDE_DOWN ? length - 1 - first - i : first + i,
+        rows
+      );
+    }
+  }
+}
+
+void MAX7219Chain::render_planned(const ChainImageView& view,
+                                  std::uint8_t* rows) const {
+
+  for (std::size_t first = 0; first < length; first += 8) {
+
+    // read the next eight matrices of the window, one matrix per word
+    std::uint64_t words[MatrixImage::HEIGHT];
+    view.get_matrix_words(first * MatrixImage::WIDTH, words);
+
+    std::size_t count{std::min<std::size_t>(8, length - first)};
+    for (std::size_t i = 0; i < count; i++) {
+      const ModulePlan& plan = transform_plan[first + i];
+      store_matrix_rows(plan.transform(words[i]), plan.position, rows);
+    }
+  }
+}
+
+void MAX7219Chain::store_matrix_rows(std::uint64_t word, std::size_t matrix,
+                                     std::uint8_t* rows) const {
+
+  // scatter the rows of the matrix into the row buffer
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    rows[row * length + matrix] = static_cast<std::uint8_t>(
+      word >> (MatrixImage::WIDTH * (MatrixImage::HEIGHT - 1 - row)));
+  }
 }
 
-std::vector<std::vector<char>*>* MAX7219Chain::image_to_command_vectors(
-    MatrixChainImage* image) {
+MAX7219Chain::RenderKernel MAX7219Chain::select_render_kernel(
+    std::size_t matrix_orientation, bool upside_down) {
+
+  // one kernel for each combination of orientation and upside down
+  static constexpr RenderKernel kernels[2][4]{
+    {
+      &MAX7219Chain::render_rows<0, false>,
+      &MAX7219Chain::render_rows<1, false>,
+      &MAX7219Chain::render_rows<2, false>,
+      &MAX7219Chain::render_rows<3, false>,
+    },
+    {
+      &MAX7219Chain::render_rows<0, true>,
+      &MAX7219Chain::render_rows<1, true>,
+      &MAX7219Chain::render_rows<2, true>,
+      &MAX7219Chain::render_rows<3, true>,
+    },
+  };
+
+  return kernels[upside_down ? 1 : 0][matrix_orientation % 4];
+}
+
+std::vector<MAX7219Chain::ModulePlan> MAX7219Chain::compile_transform_plan(
+    std::size_t length, std::size_t matrix_orientation, bool upside_down) {
+
+  // an upside down chain displays the matrices in reverse order, each
+  // rotated by an additional 180 degrees
+  std::vector<ModuleTransform> module_transforms(length);
+  for (std::size_t matrix = 0; matrix < length; matrix++) {
+    module_transforms[matrix] = {
+      matrix_orientation + (upside_down ? 2 : 0),
+      false,
+      false,
+      upside_down ? length - 1 - matrix : matrix,
+    };
+  }
+
+  return compile_transform_plan(module_transforms);
+}
+
+std::vector<MAX7219Chain::ModulePlan> MAX7219Chain::compile_transform_plan(
+    const std::vector<ModuleTransform>& module_transforms) {
+
+  std::vector<ModulePlan> plan(module_transforms.size());
+  std::vector<bool> position_used(module_transforms.size(), false);
+
+  for (std::size_t matrix = 0; matrix < module_transforms.size(); matrix++) {
+
+    const ModuleTransform& module = module_transforms[matrix];
+
+    // throw an exception if the position is outside of the chain or if
+    // another matrix is already displayed there
+    if (module.position >= module_transforms.size()
+        || position_used[module.position]) {
+      throw std::invalid_argument{
+        std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+        + "module positions must name each of the "
+        + std::to_string(module_transforms.size())
+        + " matrices in the chain once; position for matrix "
+        + std::to_string(matrix) + " was "
+        + std::to_string(module.position)
+      };
+    }
+
+    position_used[module.position] = true;
+    plan[matrix] = {
+      module.position,
+      MatrixImage::get_transform(module.rotation, module.mirror_horizontal,
+                                 module.mirror_vertical),
+    };
+  }
+
+  return plan;
+}
+
+std::uint64_t MAX7219Chain::hash_transform_plan(
+    const std::vector<ModulePlan>& transform_plan) {
+
+  // a matrix with two pixels along one edge from a corner is moved to a
+  // different place by each of the eight rotations and mirrorings, so it
+  // identifies a module's transform
+  const std::uint64_t probe{0xC000000000000000};
+
+  // FNV-1a over the position and transformed probe of every module
+  std::uint64_t hash{0xCBF29CE484222325};
+  for (const ModulePlan& module : transform_plan) {
+    for (std::uint64_t value : {static_cast<std::uint64_t>(module.position),
+                                module.transform(probe)}) {
+      for (std::size_t byte = 0; byte < 8; byte++) {
+        hash ^= (value >> (8 * byte)) & 0xFF;
+        hash *= 0x100000001B3;
+      }
+    }
+  }
+
+  // 0 identifies chains with a single orientation
+  return hash != 0 ? hash : 1;
+}
+
+std::vector<std::vector<char>> MAX7219Chain::image_to_command_vectors(
+    const MatrixChainImage& image) {
 
   // create a 2D vector container to hold a series of commands for each row in
   // the matrix
-  std::vector<std::vector<char>*>* command_vectors = 
-    new std::vector<std::vector<char>*>(MatrixImage::HEIGHT);
+  std::vector<std::vector<char>> command_vectors(
+    MatrixImage::HEIGHT, std::vector<char>(2 * image.length));
 
   // for each row of the matrices
   for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
 
-    // create a vector to hold the commands for this row
-    command_vectors->at(row) = new std::vector<char>(2 * image->length);
-
     // for each matrix in the chain
-    for (std::size_t matrix = 0; matrix < image->length; matrix++) {
+    for (std::size_t matrix = 0; matrix < image.length; matrix++) {
 
       // add the row register to the command vector
-      command_vectors->at(row)->at(2 * matrix) = 
-        row_index_to_row_register(row);
+      command_vectors[row][2 * matrix] = row_index_to_row_register(row);
 
       // add the row data to the command vector
-      command_vectors->at(row)->at(2 * matrix + 1) = 
-        image->get_row_of_matrix(matrix, row);
+      command_vectors[row][2 * matrix + 1] =
+        image.get_row_of_matrix(matrix, row);
 
     }
   }
 
-  delete image;
-
   return command_vectors;
 }
 
 void MAX7219Chain::send_command_vectors(
-    std::vector<std::vector<char>*>* command_vectors) {
+    std::vector<std::vector<char>>& command_vectors) {
+
+  std::array<SPITransport::Transaction, MatrixImage::HEIGHT> transactions;
 
   // for each row of the matrix
   for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
 
-    // send the command for the row via SPI and deallocate the memory 
-    // associated with the row's command vector
-    send_command_string(command_vectors->at(row));
+    // each row is its own transaction so that it is latched separately
+    transactions.at(row) = {
+      command_vectors.at(row).data(),
+      static_cast<std::uint32_t>(command_vectors.at(row).size())
+    };
+  }
+
+  std::lock_guard<std::mutex> bus_lock{bus_mutex};
+
+  // send the commands for all of the rows in a single batch
+  transport.transfer_batch(transactions.data(), transactions.size());
+
+  // pre-generated commands are not tracked, so the next frame must be sent
+  // in full
+  latched_rows_valid = false;
+}
+
+void MAX7219Chain::display(const MatrixChainImage& image) {
+  display(image, 0);
+}
+
+void MAX7219Chain::display(const MatrixChainImage& image,
+                           std::size_t column_offset) {
+  display(ChainImageView{image, column_offset,
+                         length * MatrixImage::WIDTH});
+}
+
+void MAX7219Chain::display(const ChainImageView& view) {
+
+  // crop, orient and serialize the view into row data in a single pass and
+  // display it on the matrix
+  send_frame([this, &view](std::uint8_t* rows) {
+    (this->*render_kernel)(view, rows);
+  });
+
+}
+
+void MAX7219Chain::display(const FrameStore& store, std::size_t frame) {
+  check_recorded_length(store.get_length());
+  check_recorded_transform_table(store.get_transform_table_id());
+  send_stored_rows(store.get_frame(frame));
+}
+
+void MAX7219Chain::display(const FrameDecoder& decoder) {
+
+  const FrameFile& file = decoder.get_file();
+  check_recorded_length(file.get_length());
+  check_recorded_transform_table(file.get_transform_table_id());
+
+  // throw an exception if the frames were recorded for another orientation
+  if (file.get_matrix_orientation() != matrix_orientation % 4
+      || file.is_upside_down() != upside_down) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "frame file orientation "
+      + std::to_string(file.get_matrix_orientation())
+      + (file.is_upside_down() ? " upside down" : "")
+      + " does not match chain orientation "
+      + std::to_string(matrix_orientation % 4)
+      + (upside_down ? " upside down" : "")
+    };
   }
 
-  delete command_vectors;
+  // the decoded rows are compared with the latched rows as they are sent, so
+  // only the rows that the frame changed reach the device
+  send_stored_rows(decoder.get_rows());
 }
 
-void MAX7219Chain::display(MatrixChainImage& image) {
+void MAX7219Chain::record_frame(const ChainImageView& view,
+                                FrameStore& store) const {
+
+  check_recorded_length(store.get_length());
+
+  // an empty store holds frames for whichever chain records into it first
+  if (store.get_frame_count() == 0) {
+    store.set_transform_table_id(transform_table_id);
+  }
+  check_recorded_transform_table(store.get_transform_table_id());
+
+  (this->*render_kernel)(view, store.append_frame());
+}
 
-  // get a cropped version of this image
-  MatrixChainImage* cropped_image = image.get_cropped_image(length);
+void MAX7219Chain::send_stored_rows(const std::uint8_t* stored_rows) {
 
-  // apply necessary preprocessing to the image (in place)
-  preprocess(*cropped_image);
+  // stored rows are laid out like the rows that are rendered for a frame, so
+  // they are copied into the frame buffer as they are
+  std::size_t frame_size{MatrixImage::HEIGHT * length};
+  send_frame([stored_rows, frame_size](std::uint8_t* rows) {
+    std::copy(stored_rows, stored_rows + frame_size, rows);
+  });
+}
 
-  // create command vectors from the image
-  auto image_commands = image_to_command_vectors(cropped_image);
-  cropped_image = nullptr;
+void MAX7219Chain::check_recorded_length(std::size_t recorded_length) const {
 
-  // display the image on the matrix
-  send_command_vectors(image_commands);
-  image_commands = nullptr;
+  // throw an exception if the frames are for a chain of another length
+  if (recorded_length != length) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "recorded frame length must equal chain length of "
+      + std::to_string(length) + "; recorded length was "
+      + std::to_string(recorded_length)
+    };
+  }
+}
 
+void MAX7219Chain::check_recorded_transform_table(
+    std::uint64_t recorded_id) const {
+
+  // throw an exception if the frames are for a chain whose modules are
+  // transformed differently; they would be displayed scrambled
+  if (recorded_id != transform_table_id) {
+    throw std::invalid_argument{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "recorded module transform table "
+      + std::to_string(recorded_id)
+      + " does not match chain module transform table "
+      + std::to_string(transform_table_id)
+    };
+  }
 }
 
-std::vector<std::vector<char>*>* MAX7219Chain::generate_frame(
-    MatrixChainImage* image) {
+std::vector<std::vector<char>> MAX7219Chain::generate_frame(
+    const MatrixChainImage& image) {
   
-  // perform necessary transformations to the image
-  preprocess(*image);
+  // perform necessary transformations on a copy of the image, leaving the
+  // caller's image unmodified
+  MatrixChainImage frame{image};
+  preprocess(frame);
 
-  // generate command vectors for the image and return a pointer
-  return image_to_command_vectors(image);
-}
\ No newline at end of file
+  // generate command vectors for the image
+  return image_to_command_vectors(frame);
+}
@@ -5,7 +5,10 @@
  */
 
 #include <vector>
+#include <string>
 #include <exception>
+#include <stdexcept>
+#include <algorithm>
 
 #include "MatrixChainImage.h"
 
@@ -19,12 +22,32 @@ void MatrixChainImage::draw_character(std::uint_fast8_t code_point,
 void MatrixChainImage::draw_character(std::uint_fast8_t code_point,
                                       std::size_t position, Font& font) {
 
-  // for each row index in the glyph
-  for (std::size_t i = 0; i < Glyph::HEIGHT; i++) {
+  std::size_t width{font.get_glyph_width(code_point)};
 
-    // for each column in the glyph
-    for (std::size_t j = 0; j < font.get_glyph_width(code_point); j++) {
-      set_pixel(i, position + j, font.get_pixel(code_point, i, j));
+  // throw an exception if the glyph does not fit on the image
+  if (position + width > get_pixel_width()) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "glyph of width " + std::to_string(width) + " at column "
+      + std::to_string(position) + " exceeds image width of "
+      + std::to_string(get_pixel_width())
+    };
+  }
+
+  // the glyph covers part of one matrix, or parts of two adjacent matrices
+  // when it does not start on a matrix boundary
+  const Font::ShiftedGlyph& glyph{
+    font.get_shifted_glyph(code_point, position % MatrixImage::WIDTH)};
+  std::size_t matrix{position / MatrixImage::WIDTH};
+
+  for (std::size_t row = 0; row < Glyph::HEIGHT; row++) {
+    write_row_of_matrix(matrix, row, glyph.first_rows[row], glyph.first_mask);
+  }
+
+  if (glyph.second_mask != 0) {
+    for (std::size_t row = 0; row < Glyph::HEIGHT; row++) {
+      write_row_of_matrix(matrix + 1, row, glyph.second_rows[row],
+                          glyph.second_mask);
     }
   }
 }
@@ -58,124 +81,235 @@ std::string MatrixChainImage::draw_text(const std::string& text, Font& font) {
 
 }
 
-void MatrixChainImage::left_shift_image() {
+void MatrixChainImage::clear() {
+  std::fill(image_data.begin(), image_data.end(), 0);
+  cursor_position = 0;
+}
+
+void MatrixChainImage::left_shift_image(std::size_t columns) {
 
-  // for each row in the matrices
+  // for each row in the image
   for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    shift_row_left(image_data.data() + row * words_per_row, columns);
+  }
 
-    // add a new column of 0's on the rightmost edge
-    uint8_t fill_bit = 0;
+  // move the cursor to adjust for the movement of the image; the cursor
+  // cannot move further to the left than position 0
+  cursor_position -= std::min(cursor_position, columns);
 
-    // iterate over the matrices in the chain in reverse order
-    for (auto matrix_reverse_iter = matrices.rbegin();
-         matrix_reverse_iter != matrices.rend(); 
-         matrix_reverse_iter++) {
+}
 
-      fill_bit = (*matrix_reverse_iter)->left_shift_row(row, fill_bit);
-    }
+void MatrixChainImage::right_shift_image(std::size_t columns) {
+
+  // for each row in the image
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    shift_row_right(image_data.data() + row * words_per_row, columns);
+  }
+
+  // move the cursor to adjust for the movement of the image; the cursor
+  // cannot move beyond the right edge of the image
+  cursor_position = std::min(cursor_position + columns, get_pixel_width());
+
+}
+
+void MatrixChainImage::shift_row_left(std::uint64_t* row_data,
+                                      std::size_t columns) const {
+
+  std::size_t word_shift{columns / 64};
+  unsigned int bit_shift{static_cast<unsigned int>(columns % 64)};
+
+  // each word is built from the two source words that the shift moves into
+  // it; source words are always at or after the destination word, so the
+  // row can be shifted in place from left to right, and a new column of 0's
+  // is added on the rightmost edge since the unused bits of the last word
+  // are always 0
+  for (std::size_t word = 0; word < words_per_row; word++) {
+
+    std::size_t source{word + word_shift};
+    std::uint64_t high{source < words_per_row ? row_data[source] : 0};
+    std::uint64_t low{source + 1 < words_per_row ? row_data[source + 1] : 0};
+
+    row_data[word] = bit_shift == 0
+      ? high
+      : (high << bit_shift) | (low >> (64 - bit_shift));
   }
+}
+
+void MatrixChainImage::shift_row_right(std::uint64_t* row_data,
+                                       std::size_t columns) const {
+
+  std::size_t word_shift{columns / 64};
+  unsigned int bit_shift{static_cast<unsigned int>(columns % 64)};
+
+  // source words are always at or before the destination word, so the row
+  // is shifted in place from right to left
+  for (std::size_t word = words_per_row; word-- > 0;) {
+
+    std::uint64_t low{word >= word_shift ? row_data[word - word_shift] : 0};
+    std::uint64_t high{
+      word >= word_shift + 1 ? row_data[word - word_shift - 1] : 0};
 
-  // move the cursor to adjust for the movement of the image unless the cursor
-  // is already at position 0 in which case it cannot move further to the left
-  if (cursor_position != 0) {
-    cursor_position--;
+    row_data[word] = bit_shift == 0
+      ? low
+      : (low >> bit_shift) | (high << (64 - bit_shift));
   }
 
+  // columns that were shifted past the right edge of the image must not be
+  // kept in the unused bits of the last word
+  if (words_per_row != 0) {
+    row_data[words_per_row - 1] &= last_word_mask();
+  }
 }
 
-// NEED TO LOOK AT THIS AGAIN - THIS IMPL MAY NOT BE BEST
 void MatrixChainImage::rotate_matrices(std::size_t rotation) {
 
-  // rotate each individual matrix within the chain in place
-  for (auto matrix_iter = matrices.begin();
-       matrix_iter != matrices.end(); 
-       matrix_iter++) {
+  // nothing needs to be done if the rotation is by 0 degrees
+  if (rotation % 4 == 0) { return; }
+
+  transform_matrices(MatrixImage::get_rotation(rotation));
+}
+
+MatrixChainImage MatrixChainImage::get_cropped_image(
+    std::size_t length) const {
+
+  // create a new, blank chain image and copy the cropped data into it
+  MatrixChainImage cropped_image{length};
+  get_cropped_image(cropped_image);
+  
+  return cropped_image;
+}
 
-    (*matrix_iter)->rotate_image(rotation);
+void MatrixChainImage::get_cropped_image(
+    MatrixChainImage& cropped_image) const {
+
+  // throw an exception if the cropped image is longer than this image
+  if (cropped_image.length > length) {
+    throw std::out_of_range{
+      std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+      + "cropped image length must not exceed image length of "
+      + std::to_string(length) + "; provided value was "
+      + std::to_string(cropped_image.length)
+    };
   }
 
+  // an empty image has no data to copy
+  if (cropped_image.words_per_row == 0) {
+    return;
+  }
+
+  // bits of the last word of each row that are part of the cropped image
+  std::uint64_t last_word_mask{cropped_image.last_word_mask()};
+
+  // for each row in the cropped image
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+
+    const std::uint64_t* source = image_data.data() + row * words_per_row;
+    std::uint64_t* destination = 
+      cropped_image.image_data.data() + row * cropped_image.words_per_row;
+
+    // copy whole words of the row and clear the bits of the last word that
+    // are beyond the width of the cropped image
+    std::copy(source, source + cropped_image.words_per_row, destination);
+    destination[cropped_image.words_per_row - 1] &= last_word_mask;
+  }
 }
 
-MatrixChainImage* MatrixChainImage::get_cropped_image(std::size_t length) {
+void MatrixChainImage::get_window(MatrixChainImage& window,
+                                  std::size_t column_offset,
+                                  bool wrap) const {
 
-  // create a new, blank chain image
-  MatrixChainImage* cropped_image{new MatrixChainImage(length)};
+  std::size_t width{get_pixel_width()};
 
-  // for each matrix index in the cropped image
-  for (std::size_t matrix = 0; matrix < length; matrix++) {
+  // an empty window has no data to copy, and an empty image has nothing to
+  // repeat when wrapping
+  if (window.words_per_row == 0 || (wrap && width == 0)) {
+    return;
+  }
 
-    // for each row in each matrix
-    for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+  if (wrap) {
+    column_offset %= width;
+  }
 
-      // retrieve the row value for this image and store it into the cropped
-      // image
-      std::uint_fast8_t image_row_value = get_row_of_matrix(matrix, row);
-      cropped_image->set_row_of_matrix(matrix, row, image_row_value);
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+
+    std::uint64_t* destination = 
+      window.image_data.data() + row * window.words_per_row;
+
+    for (std::size_t word = 0; word < window.words_per_row; word++) {
+
+      std::size_t column{column_offset + 64 * word};
+
+      if (!wrap) {
+        destination[word] = read_row_bits(row, column);
+        continue;
+      }
+
+      // columns past the right edge read as 0, so the start of the image
+      // can be OR-ed in after them as many times as is needed to fill the
+      // word (more than once if the image is narrower than a word)
+      column %= width;
+      std::uint64_t bits{read_row_bits(row, column)};
+      for (std::size_t filled = width - column; filled < 64;
+           filled += width) {
+        bits |= read_row_bits(row, 0) >> filled;
+      }
+
+      destination[word] = bits;
     }
+
+    // clear the bits of the last word that are beyond the width of the
+    // window
+    destination[window.words_per_row - 1] &= window.last_word_mask();
   }
-  
-  return cropped_image;
+}
+
+std::size_t MatrixChainImage::get_text_length(const std::string& text,
+                                              Font& font) {
+
+  // round up to a whole number of matrices
+  return (get_text_width(text, font) + MatrixImage::WIDTH - 1)
+         / MatrixImage::WIDTH;
+}
+
+std::size_t MatrixChainImage::get_text_width(const std::string& text,
+                                             Font& font) {
+
+  // add up the widths of all of the glyphs in the text
+  std::size_t text_width{0};
+  for (char character : text) {
+    text_width += font.get_glyph_width(
+      static_cast<std::uint_fast8_t>(character));
+  }
+
+  return text_width;
 }
 
 void MatrixChainImage::rotate_image(std::size_t rotation) {
 
   // rotating by 180 degrees * rotation is equivalent to rotating by
-  // 180 degrees * (rotation % 2)
-  switch (rotation % 2) {
-
-  case 0:
-
-    // if we are rotating 180 degrees * 0, there is nothing to do
-    break;
-
-  case 1:
-
-    // for each 8x8 matrix in the image
-    for (std::size_t matrix{0}; matrix < length; matrix++) {
-
-      // for each of the rows in the top half of the matrix
-      for (std::size_t row{0}; row < MatrixImage::HEIGHT / 2; row++) {
-        
-        // to rotate 180 degrees, we can swap entire rows of a matrix at a 
-        // time; we specify two matrix rows in the image that need to be
-        // swapped, a and b, and we swap their locations and then reverse the
-        // order of the bits in the row
-
-        // location a is an arbitrary location that is bound to the top half of
-        // image
-        std::size_t swap_matrix_a{matrix};
-        std::size_t swap_row_a{row};
-
-        // location b is the location of a if the image were rotated 180
-        // degrees; by nature, it is bound to the bottom half of the image
-        std::size_t swap_matrix_b{length - 1 - matrix};
-        std::size_t swap_row_b{MatrixImage::HEIGHT - 1 - row};
-
-        // get the row values at position a and b
-        std::uint_fast8_t row_value_a{
-          get_row_of_matrix(swap_matrix_a, swap_row_a)};
-        std::uint_fast8_t row_value_b{
-          get_row_of_matrix(swap_matrix_b, swap_row_b)};
-
-        // set the value at position b as the reversed value from position a
-        set_row_of_matrix(
-          swap_matrix_b,
-          swap_row_b,
-          MatrixImage::reverse_bits_lookup_table[row_value_a]
-        );
-
-        // set the value at position a as the reversed value from position b
-        set_row_of_matrix(
-          swap_matrix_a,
-          swap_row_a,
-          MatrixImage::reverse_bits_lookup_table[row_value_b]
-        );
+  // 180 degrees * (rotation % 2), and rotating by 0 degrees does nothing
+  if (rotation % 2 == 0 || words_per_row == 0) { return; }
 
-      }
+  // number of bits at the end of each row that are beyond the image width
+  std::size_t padding{64 * words_per_row - get_pixel_width()};
 
+  // reverse each row as a whole: reverse the order of its words, reverse
+  // the bits of each word, and shift out the padding that is now in front
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT; row++) {
+    std::uint64_t* row_data = image_data.data() + row * words_per_row;
+    std::reverse(row_data, row_data + words_per_row);
+    for (std::size_t word = 0; word < words_per_row; word++) {
+      row_data[word] = MatrixImage::rotate_word_180(row_data[word]);
     }
+    shift_row_left(row_data, padding);
+  }
 
-    break;
-
+  // then reverse the order of the rows
+  for (std::size_t row = 0; row < MatrixImage::HEIGHT / 2; row++) {
+    std::swap_ranges(
+      image_data.begin() + row * words_per_row,
+      image_data.begin() + (row + 1) * words_per_row,
+      image_data.begin() + (MatrixImage::HEIGHT - 1 - row) * words_per_row
+    );
   }
 }
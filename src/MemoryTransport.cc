@@ -0,0 +1,28 @@
+/**
+ * @file MemoryTransport.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <vector>
+#include <cstdint>
+
+#include "MemoryTransport.h"
+
+int MemoryTransport::init() {
+  initialized = true;
+  return 1;
+}
+
+int MemoryTransport::close() {
+  initialized = false;
+  return 1;
+}
+
+void MemoryTransport::do_transfer(char* buffer, std::uint32_t buffer_length) {
+
+  // store a copy of the transaction if recording is enabled
+  if (recording) {
+    transactions.emplace_back(buffer, buffer + buffer_length);
+  }
+}
@@ -0,0 +1,141 @@
+/**
+ * @file SpidevTransport.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+#include "SpidevTransport.h"
+
+namespace {
+
+/**
+ * Largest number of transfers that fit in a single `SPI_IOC_MESSAGE` ioctl;
+ * the size of the transfer array is encoded in the ioctl request number.
+ */
+const std::size_t MAX_TRANSFERS_PER_MESSAGE{
+  ((1 << _IOC_SIZEBITS) - 1) / sizeof(spi_ioc_transfer)};
+
+}  // namespace
+
+SpidevTransport::SpidevTransport(std::string device_path,
+                                 std::uint32_t speed_hz)
+  : device_path{device_path}
+  , speed_hz{speed_hz}
+  , file_descriptor{-1}
+  , transfers(8) { /* no body */ }
+
+SpidevTransport::~SpidevTransport() {
+  if (file_descriptor >= 0) {
+    close();
+  }
+}
+
+int SpidevTransport::init() {
+
+  // reinitializing must not leak the descriptor that is already open
+  if (file_descriptor >= 0) {
+    close();
+  }
+
+  file_descriptor = open(device_path.c_str(), O_RDWR);
+  if (file_descriptor < 0) {
+    return 0;
+  }
+
+  std::uint8_t mode{SPI_MODE_0};
+  std::uint8_t lsb_first{0};
+  std::uint8_t bits_per_word{8};
+
+  // configure the bus for the MAX7219; close the device if any option is
+  // rejected by the driver
+  std::uint32_t max_speed_hz{speed_hz};
+  if (control(SPI_IOC_WR_MODE, &mode) < 0
+      || control(SPI_IOC_WR_LSB_FIRST, &lsb_first) < 0
+      || control(SPI_IOC_WR_BITS_PER_WORD, &bits_per_word) < 0
+      || control(SPI_IOC_WR_MAX_SPEED_HZ, &max_speed_hz) < 0) {
+    close();
+    return 0;
+  }
+
+  return 1;
+}
+
+int SpidevTransport::close() {
+
+  // the device was never opened, or init() failed and already closed it
+  if (file_descriptor < 0) {
+    return 0;
+  }
+
+  int return_code = ::close(file_descriptor);
+  file_descriptor = -1;
+  return return_code == 0;
+}
+
+int SpidevTransport::control(unsigned long request, void* argument) {
+  return ioctl(file_descriptor, request, argument);
+}
+
+void SpidevTransport::do_transfer(char* buffer, std::uint32_t buffer_length) {
+  Transaction transaction{buffer, buffer_length};
+  do_transfer_batch(&transaction, 1);
+}
+
+void SpidevTransport::do_transfer_batch(Transaction* transactions,
+                                        std::size_t transaction_count) {
+
+  if (transfers.size() < transaction_count) {
+    transfers.resize(std::min(transaction_count, MAX_TRANSFERS_PER_MESSAGE));
+  }
+
+  // batches larger than a single ioctl can carry are split into several
+  // messages; in practice a frame is always 8 transfers
+  for (std::size_t first = 0; first < transaction_count;
+       first += MAX_TRANSFERS_PER_MESSAGE) {
+
+    std::size_t count{
+      std::min(transaction_count - first, MAX_TRANSFERS_PER_MESSAGE)};
+
+    for (std::size_t i = 0; i < count; i++) {
+
+      spi_ioc_transfer& transfer = transfers[i];
+      std::memset(&transfer, 0, sizeof(transfer));
+
+      transfer.tx_buf = reinterpret_cast<std::uintptr_t>(
+        transactions[first + i].buffer);
+      transfer.len = transactions[first + i].length;
+      transfer.speed_hz = speed_hz;
+      transfer.bits_per_word = 8;
+
+      // release chip select after every transfer except the last one (where
+      // it is released anyway at the end of the message) so that each
+      // transaction is latched by the MAX7219 chips
+      transfer.cs_change = (i + 1 < count);
+    }
+
+    // the request number is built by hand because `SPI_IOC_MESSAGE()` only
+    // accepts a constant transfer count in C++
+    unsigned long request{
+      _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, count * sizeof(spi_ioc_transfer))};
+
+    if (control(request, transfers.data()) < 0) {
+      throw std::runtime_error{
+        std::string{__FILE__} + ":" + std::to_string(__LINE__) + "\t"
+        + "SPI transfer to " + device_path + " failed: "
+        + std::strerror(errno)
+      };
+    }
+  }
+}
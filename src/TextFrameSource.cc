@@ -0,0 +1,99 @@
+/**
+ * @file TextFrameSource.cc
+ * @author Arian Deimling
+ * @version 0.1.0
+ */
+
+#include <cstdint>
+#include <string>
+#include <limits>
+
+#include "TextFrameSource.h"
+
+TextFrameSource::TextFrameSource(const std::string& text, Font& font,
+                                 std::size_t length, bool wrap)
+  : text{text}
+  , font{font}
+  , window_width{length * MatrixImage::WIDTH}
+  , wrap{wrap}
+  , text_width{MatrixChainImage::get_text_width(text, font)}
+  // a glyph can start up to 7 columns before the window and be up to 8
+  // columns wide, so two extra matrices always hold the whole window
+  , strip{length + 2}
+  , frame{0}
+  , strip_glyph{0}
+  , strip_start{0}
+  , strip_end{0} { /* no body */ }
+
+void TextFrameSource::set_frame(std::size_t frame) {
+  this->frame = frame;
+}
+
+ChainImageView TextFrameSource::get_frame() {
+
+  // the window of text that wraps is kept within the text so that the
+  // glyphs under it can always be found
+  std::size_t column{frame};
+  if (wrap && text_width != 0) {
+    column %= text_width;
+  }
+
+  // redraw the strip only if the window is not entirely on its drawn part
+  if (column < strip_start || column + window_width > strip_end) {
+    draw_strip(column);
+  }
+
+  return ChainImageView{strip, column - strip_start, window_width};
+}
+
+
+void TextFrameSource::draw_strip(std::size_t column) {
+
+  // glyphs are found by walking forward from the current strip, so start
+  // over from the beginning of the text if the window has moved backwards
+  if (column < strip_start) {
+    strip_glyph = 0;
+    strip_start = 0;
+  }
+
+  // skip the glyphs that end at or before the start of the window
+  while (strip_glyph < text.length()
+         && strip_start + get_glyph_width(strip_glyph) <= column) {
+    strip_start += get_glyph_width(strip_glyph);
+    strip_glyph++;
+  }
+
+  strip.clear();
+
+  // draw glyphs from the one that covers the start of the window until the
+  // next one would not fit onto the strip
+  std::size_t position{0};
+  std::size_t glyph{strip_glyph};
+  bool text_ended{false};
+
+  while (true) {
+
+    // text that wraps continues from its first glyph; text that does not is
+    // blank beyond its end
+    if (glyph == text.length()) {
+      if (!wrap || text_width == 0) {
+        text_ended = true;
+        break;
+      }
+      glyph = 0;
+    }
+
+    std::size_t width{get_glyph_width(glyph)};
+    if (position + width > strip.get_pixel_width()) {
+      break;
+    }
+
+    strip.draw_character(static_cast<std::uint_fast8_t>(text[glyph]),
+                         position, font);
+    position += width;
+    glyph++;
+  }
+
+  strip_end = text_ended ? std::numeric_limits<std::size_t>::max()
+                         : strip_start + position;
+}
@@ -0,0 +1,316 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "MAX7219Chain.h"
+#include "MatrixChainImage.h"
+#include "MemoryTransport.h"
+#include "Font.h"
+#include "fonts/cp437.h"
+#include "TextFrameSource.h"
+#include "FrameStore.h"
+#include "FrameFile.h"
+#include "FrameDecoder.h"
+#include "FrameFileWriter.h"
+#include "FramePipeline.h"
+
+// number of heap allocations made by the program and the number of bytes
+// requested by them; the global allocation functions are replaced so that
+// allocations in the frame path can be caught; the counters are atomic since
+// the transmit and pipeline threads allocate too
+static std::atomic<std::size_t> allocation_count{0};
+static std::atomic<std::size_t> allocation_bytes{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+int main(int argc, char* argv[]) {
+
+    // number of MAX7219 chips/8x8 matrices on the simulated display, the
+    // number of frames to send, whether the image scrolls between frames, and
+    // whether frames are sent by a background thread; all can be overridden
+    // on the command line
+    const std::size_t DEVICE_LENGTH{
+        argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8};
+    const std::size_t FRAME_COUNT{
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10'000};
+    const bool SCROLL{
+        argc > 3 ? std::strtoul(argv[3], nullptr, 10) != 0 : true};
+    const bool ASYNC{
+        argc > 4 ? std::strtoul(argv[4], nullptr, 10) != 0 : false};
+
+    // draw some text onto an image that is wider than the display
+    const std::string TEXT{"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG"};
+    MatrixChainImage image{DEVICE_LENGTH * 2};
+    Font cp437(fonts::CP437, true, 1);
+    image.draw_text(TEXT, cp437);
+
+    // only count transactions; copying each one would dominate the timings
+    MemoryTransport transport{false};
+    const std::size_t ORIENTATION{1};
+    const bool UPSIDE_DOWN{true};
+    MAX7219Chain device{transport, DEVICE_LENGTH, ORIENTATION, UPSIDE_DOWN, 0};
+
+    // report the transactions made while initializing the device separately
+    // from those made while displaying frames
+    SPITransport::Statistics startup_stats = transport.get_statistics();
+    transport.reset_statistics();
+    std::size_t frame_allocations{0};
+
+    if (ASYNC) {
+        device.start_async();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i{0}; i < FRAME_COUNT; i++) {
+
+        // redraw the text once the previous text has scrolled off the image
+        if (SCROLL && i != 0 && i % image.get_pixel_width() == 0) {
+            image.draw_text(TEXT, cp437);
+        }
+
+        std::size_t allocations_before{allocation_count};
+        device.display(image);
+        frame_allocations += allocation_count - allocations_before;
+
+        if (SCROLL) {
+            image.left_shift_image();
+        }
+    }
+
+    // wait for the last frame to be sent
+    device.stop_async();
+
+    std::chrono::duration<double> elapsed{
+        std::chrono::steady_clock::now() - start};
+
+    const SPITransport::Statistics& stats = transport.get_statistics();
+
+    std::cout << "modules:                 " << DEVICE_LENGTH << std::endl;
+    std::cout << "frames:                  " << FRAME_COUNT << std::endl;
+    std::cout << "startup submissions:     "
+              << startup_stats.submission_count << " ("
+              << startup_stats.transaction_count << " transactions)"
+              << std::endl;
+    std::cout << "frames per second:       "
+              << FRAME_COUNT / elapsed.count() << std::endl;
+    std::cout << "transactions per frame:  "
+              << static_cast<double>(stats.transaction_count) / FRAME_COUNT
+              << std::endl;
+    std::cout << "submissions per frame:   "
+              << static_cast<double>(stats.submission_count) / FRAME_COUNT
+              << std::endl;
+    std::cout << "bytes per frame:         "
+              << static_cast<double>(stats.byte_count) / FRAME_COUNT
+              << std::endl;
+    std::cout << "mean submission (ns):    "
+              << (stats.submission_count
+                  ? stats.total_time.count() / stats.submission_count : 0)
+              << std::endl;
+    std::cout << "max submission (ns):     " << stats.max_time.count()
+              << std::endl;
+    std::cout << "dropped frames:          "
+              << device.get_dropped_frame_count() << std::endl;
+    std::cout << "allocations per frame:   "
+              << static_cast<double>(frame_allocations) / FRAME_COUNT
+              << std::endl;
+
+    // compare orienting and serializing a frame with the device's render
+    // kernel, which has the orientation fixed at compile time, with rotating
+    // the image one step at a time with the orientation chosen at run time
+    // and then reading out its rows
+    MatrixChainImage frame{image.get_cropped_image(DEVICE_LENGTH)};
+    FrameStore oriented_frame{DEVICE_LENGTH, 1};
+
+    auto specialized_start = std::chrono::steady_clock::now();
+    for (std::size_t i{0}; i < FRAME_COUNT; i++) {
+        oriented_frame.clear();
+        device.record_frame(ChainImageView{frame}, oriented_frame);
+    }
+    std::chrono::duration<double, std::nano> specialized_elapsed{
+        std::chrono::steady_clock::now() - specialized_start};
+
+    std::vector<std::uint8_t> oriented_rows(
+        MatrixImage::HEIGHT * DEVICE_LENGTH);
+
+    auto dynamic_start = std::chrono::steady_clock::now();
+    for (std::size_t i{0}; i < FRAME_COUNT; i++) {
+        frame.rotate_image(static_cast<std::size_t>(UPSIDE_DOWN));
+        frame.rotate_matrices(ORIENTATION);
+        for (std::size_t row{0}; row < MatrixImage::HEIGHT; row++) {
+            for (std::size_t matrix{0}; matrix < DEVICE_LENGTH; matrix++) {
+                oriented_rows[row * DEVICE_LENGTH + matrix] =
+                    frame.get_row_of_matrix(matrix, row);
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> dynamic_elapsed{
+        std::chrono::steady_clock::now() - dynamic_start};
+
+    std::cout << "orient (ns/frame):       "
+              << specialized_elapsed.count() / FRAME_COUNT << " specialized, "
+              << dynamic_elapsed.count() / FRAME_COUNT << " dynamic"
+              << std::endl;
+
+    // time drawing a long message onto a canvas that fits it exactly
+    std::string long_text;
+    for (std::size_t i{0}; i < 100; i++) {
+        long_text += TEXT;
+    }
+    MatrixChainImage canvas{
+        MatrixChainImage::get_text_length(long_text, cp437)};
+
+    auto text_start = std::chrono::steady_clock::now();
+    canvas.draw_text(long_text, cp437);
+    std::chrono::duration<double, std::nano> text_elapsed{
+        std::chrono::steady_clock::now() - text_start};
+
+    std::cout << "draw text (ns/glyph):    "
+              << text_elapsed.count() / long_text.size() << std::endl;
+
+    // time displaying every frame of the long message produced on demand
+    // rather than drawn onto a canvas first; this must not allocate either
+    TextFrameSource source{long_text, cp437, DEVICE_LENGTH};
+    std::size_t source_frames{0};
+    std::size_t allocations_before{allocation_count};
+
+    auto source_start = std::chrono::steady_clock::now();
+    for (; !source.is_finished(); source.next_frame()) {
+        device.display(source.get_frame());
+        source_frames++;
+    }
+    std::chrono::duration<double, std::nano> source_elapsed{
+        std::chrono::steady_clock::now() - source_start};
+    frame_allocations += allocation_count - allocations_before;
+
+    std::cout << "text source (ns/frame):  "
+              << source_elapsed.count() / source_frames << std::endl;
+
+    // time the same frames with rendering, serialization and transmission
+    // on separate threads; starting the threads allocates, but passing
+    // frames between them does not
+    FramePipeline pipeline{device, source};
+    source.set_frame(0);
+
+    auto pipeline_start = std::chrono::steady_clock::now();
+    std::uint64_t pipeline_frames{pipeline.run()};
+    std::chrono::duration<double, std::nano> pipeline_elapsed{
+        std::chrono::steady_clock::now() - pipeline_start};
+
+    std::cout << "pipelined (ns/frame):    "
+              << pipeline_elapsed.count() / pipeline_frames
+              << " (peak queue depth "
+              << pipeline.get_rendered_frames().get_peak_depth() << ", "
+              << pipeline.get_serialized_frames().get_peak_depth() << " of "
+              << FramePipeline::DEFAULT_CAPACITY << ")" << std::endl;
+
+    // pre-render the same frames as nested command vectors and into a frame
+    // store, and compare the memory that each of them takes
+    std::size_t vectors_bytes_before{allocation_bytes};
+    std::vector<std::vector<std::vector<char>>> command_frames;
+    MatrixChainImage window{DEVICE_LENGTH};
+    for (source.set_frame(0); !source.is_finished(); source.next_frame()) {
+        canvas.get_window(window, source.get_frame_index());
+        command_frames.push_back(device.generate_frame(window));
+    }
+    std::size_t vectors_bytes{allocation_bytes - vectors_bytes_before};
+
+    std::size_t store_bytes_before{allocation_bytes};
+    FrameStore store{DEVICE_LENGTH, source_frames};
+    for (source.set_frame(0); !source.is_finished(); source.next_frame()) {
+        device.record_frame(source.get_frame(), store);
+    }
+    std::size_t store_bytes{allocation_bytes - store_bytes_before};
+
+    std::cout << "stored frame (bytes):    "
+              << static_cast<double>(store_bytes) / source_frames
+              << " frame store, "
+              << static_cast<double>(vectors_bytes) / source_frames
+              << " command vectors" << std::endl;
+
+    // time playing the stored frames back; this must not allocate either
+    allocations_before = allocation_count;
+    auto playback_start = std::chrono::steady_clock::now();
+    for (std::size_t i{0}; i < store.get_frame_count(); i++) {
+        device.display(store, i);
+    }
+    std::chrono::duration<double, std::nano> playback_elapsed{
+        std::chrono::steady_clock::now() - playback_start};
+    frame_allocations += allocation_count - allocations_before;
+
+    std::cout << "playback (ns/frame):     "
+              << playback_elapsed.count() / store.get_frame_count()
+              << std::endl;
+
+    // write the same frames to a frame file and time playing them back from
+    // its mapping; this must not allocate either
+    const std::string FRAME_FILE_NAME{"/tmp/scroller-benchmark.frames"};
+    {
+        FrameFileWriter writer{FRAME_FILE_NAME, device,
+                               std::chrono::milliseconds{100}};
+        for (source.set_frame(0); !source.is_finished();
+             source.next_frame()) {
+            writer.write_frame(source.get_frame());
+        }
+        writer.close();
+    }
+
+    {
+        FrameFile frame_file{FRAME_FILE_NAME};
+        FrameDecoder decoder{frame_file};
+
+        // encoded frames take far less space than the stored frames above
+        std::cout << "encoded frame (bytes):   "
+                  << static_cast<double>(frame_file.get_file_size()
+                                         - FrameFile::HEADER_SIZE)
+                     / frame_file.get_frame_count()
+                  << std::endl;
+
+        allocations_before = allocation_count;
+        auto file_start = std::chrono::steady_clock::now();
+        for (std::size_t i{0}; i < frame_file.get_frame_count(); i++) {
+            decoder.seek(i);
+            if (decoder.get_changed_rows() != 0) {
+                device.display(decoder);
+            }
+        }
+        std::chrono::duration<double, std::nano> file_elapsed{
+            std::chrono::steady_clock::now() - file_start};
+        frame_allocations += allocation_count - allocations_before;
+
+        std::cout << "frame file (ns/frame):   "
+                  << file_elapsed.count() / frame_file.get_frame_count()
+                  << std::endl;
+    }
+    std::remove(FRAME_FILE_NAME.c_str());
+
+    // displaying a frame must not allocate memory once the device has been
+    // constructed
+    if (frame_allocations != 0) {
+        std::cerr << "error: " << frame_allocations
+                  << " heap allocations in the frame path" << std::endl;
+        return 1;
+    }
+
+}
@@ -1,24 +1,24 @@
-#ifdef _WIN32
-    #include <Windows.h>
-    #define sleep(x) Sleep(x)
-#else
-    #include <unistd.h>
-    #define sleep(x) usleep(1000*x)
-#endif
-
 #include "MatrixChainImage.h"
 #include "Font.h"
+#include "fonts/cp437.h"
+#include "FrameScheduler.h"
 
 void print_matrix_chain_image(const MatrixChainImage& img);
 
 int main() {
 
     MatrixChainImage my_chain{16};
-    Font cp437("./cp437.scrollerfont", true, 1);
+    Font cp437(fonts::CP437, true, 1);
 
     my_chain.draw_text("Hello World ", cp437);
 
     print_matrix_chain_image(my_chain);
+
+    // scroll at 10 frames per second regardless of how long printing takes
+    FrameScheduler scheduler{
+        10.0, FrameScheduler::MissedDeadlinePolicy::CATCH_UP};
+    scheduler.wait_for_next_frame();
+
     // my_chain.left_shift_image();
     // print_matrix_chain_image(my_chain);
     // my_chain.left_shift_image();
@@ -26,7 +26,7 @@ int main() {
 
 
     for (int i = 0; i < 10; i++) {
-        sleep(100);
+        scheduler.wait_for_next_frame();
         my_chain.left_shift_image();
         print_matrix_chain_image(my_chain);
     }
@@ -34,7 +34,7 @@ int main() {
     my_chain.draw_text("Bye!", cp437);
 
     for (int i = 0; i < 102; i++) {
-        sleep(100);
+        scheduler.wait_for_next_frame();
         my_chain.left_shift_image();
         print_matrix_chain_image(my_chain);
     }
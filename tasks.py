@@ -2,7 +2,7 @@ from invoke import task
 import os
 import glob
 
-targets = ['matrix', 'terminal',]
+targets = ['matrix', 'terminal', 'benchmark',]
 
 library_source_dir = './libraries/'
 
@@ -18,12 +18,15 @@ project_source_dir = './src/'
 project_header_dir = './include/'
 project_build_dir = './build/'
 
+font_source_dir = './'
+font_header_dir = f'{project_header_dir}fonts/'
+
 optimization = 'O0'
 
 CC = 'gcc'
 CCFLAGS = f'-Wall -Wextra -Wpedantic -g -{optimization}'
 CXX = 'g++'
-CXXFLAGS = f'{CCFLAGS} --std=c++17'
+CXXFLAGS = f'{CCFLAGS} --std=c++17 -pthread'
 LDFLAGS = f'-L{library_files_dir} ' + ' '.join([f'-l{lib}' for lib in libraries])
 AR = 'ar'
 AROPTS = 'rcs'
@@ -138,7 +141,116 @@ def build_libraries(c, library=None):
             f'{" ".join(object_files)}'
         )
 
-@task(pre=[build_directories, build_libraries])
+def generate_font_header(font_file, header_file):
+
+    name = os.path.splitext(os.path.basename(font_file))[0]
+    guard = f'SCROLLER_FONTS_{name.upper()}_H_'
+
+    with open(font_file, 'rb') as f:
+        font_data = f.read()
+
+    # a raw font holds 8 rows for each of the 256 code points
+    if len(font_data) != 256 * 8:
+        raise ValueError(f'{font_file} must hold {256 * 8} bytes of glyph data')
+
+    lines = [
+        '/**',
+        f' * @file {name}.h',
+        f' * Generated from {os.path.basename(font_file)} by `invoke build-fonts`;',
+        ' * do not edit.',
+        ' */',
+        '',
+        f'#ifndef {guard}',
+        f'#define {guard}',
+        '',
+        '#include <cstdint>',
+        '',
+        '#include "Font.h"',
+        '',
+        'namespace fonts {',
+        '',
+        '/**',
+        f' * Glyph data of the {name} font, laid out like a `.scrollerfont` file.',
+        ' */',
+        f'inline constexpr std::uint8_t {name.upper()}[Font::FONT_DATA_SIZE]{{',
+    ]
+
+    # one line of eight rows for each glyph
+    for code_point in range(256):
+        rows = font_data[code_point * 8:(code_point + 1) * 8]
+        lines.append(
+            '  ' + ', '.join(f'0x{row:02X}' for row in rows)
+            + f',  // 0x{code_point:02X}'
+        )
+
+    lines += [
+        '};',
+        '',
+        '}  // namespace fonts',
+        '',
+        f'#endif  // {guard}',
+        '',
+    ]
+
+    # headers in this project use CRLF line endings
+    with open(header_file, 'w', newline='\r\n') as f:
+        f.write('\n'.join(lines))
+
+@task
+def build_fonts(c):
+
+    # create a directory to hold the generated font headers
+    c.run(f'mkdir -p {font_header_dir}')
+
+    # turn each font file into a header holding its glyph data as a constexpr
+    # table so that fonts can be compiled into the program
+    for font_file in glob.glob(f'{font_source_dir}*.scrollerfont'):
+        name = os.path.splitext(os.path.basename(font_file))[0]
+        generate_font_header(font_file, f'{font_header_dir}{name}.h')
+
+def glyph_metrics(rows, code_point):
+
+    # the columns with any pixel set in any row of the glyph
+    columns = 0
+    for row in rows:
+        columns |= row
+
+    # blank glyphs are special: a space is 4 columns wide plus spacing, and
+    # code point 0xFF is a single column used to separate characters that
+    # does not take spacing (Glyph::FIXED_ADVANCE); see
+    # Font::RAW_BLANK_GLYPH_METRICS
+    if columns == 0:
+        return {0x20: (4, 0, 0), 0xFF: (1, 0, 0x01)}.get(code_point, (0, 0, 0))
+
+    left_bearing = 8 - columns.bit_length()
+    right_bearing = (columns & -columns).bit_length() - 1
+    return 8 - left_bearing - right_bearing, left_bearing, 0
+
+@task
+def convert_font(c, font, output):
+
+    with open(font, 'rb') as f:
+        font_data = f.read()
+
+    # a raw font holds 8 rows for each of the 256 code points
+    if len(font_data) != 256 * 8:
+        raise ValueError(f'{font} must hold {256 * 8} bytes of glyph data')
+
+    glyphs = [font_data[i * 8:(i + 1) * 8] for i in range(256)]
+    metrics = [glyph_metrics(rows, i) for i, rows in enumerate(glyphs)]
+
+    # write a font container (see include/FontFile.h): the header, the
+    # advance, left bearing and flags of each glyph, and then the glyph data
+    header = b'SCRF' + (2).to_bytes(2, 'little') + (256).to_bytes(2, 'little')
+    header += bytes([8, 0, 0, 0])
+
+    with open(output, 'wb') as f:
+        f.write(header)
+        for field in range(3):
+            f.write(bytes(glyph[field] for glyph in metrics))
+        f.write(font_data)
+
+@task(pre=[build_directories, build_libraries, build_fonts])
 def build(c):
 
     # generate a list of source code files for the project